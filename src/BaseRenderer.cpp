@@ -25,10 +25,17 @@ BaseRenderer::BaseRenderer(QWidget *parent)
     : QOpenGLWidget(parent)
 {
     setFocusPolicy(Qt::StrongFocus);
+    
+    // 注册到全局帧调度器，隐藏或暂停时自动停止
+    FrameScheduler::instance()->registerClient(this, [this](float deltaTime) {
+        return tick(deltaTime);
+    });
 }
 
 BaseRenderer::~BaseRenderer()
 {
+    FrameScheduler::instance()->unregisterClient(this);
+    
     makeCurrent();
     
     quadVAO.destroy();
@@ -208,11 +215,18 @@ void BaseRenderer::setCameraPosition(const QVector2D &position)
 
 void BaseRenderer::setCameraZoom(float zoom)
 {
-    cameraZoom = std::max(0.1f, std::min(zoom, 10.0f));  // 限制范围
+    cameraZoom = std::max(minCameraZoom, std::min(zoom, maxCameraZoom));  // 限制范围
     updateProjectionMatrix();
     update();
 }
 
+void BaseRenderer::setCameraZoomRange(float minZoom, float maxZoom)
+{
+    minCameraZoom = std::max(0.0001f, minZoom);
+    maxCameraZoom = std::max(minCameraZoom, maxZoom);
+    setCameraZoom(cameraZoom);
+}
+
 void BaseRenderer::createQuadGeometry(float width, float height)
 {
     quadVAO.create();
@@ -275,6 +289,15 @@ void BaseRenderer::createTextureFromImage(const QImage &image, GLuint &textureId
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+void BaseRenderer::deleteTexture(GLuint &textureId)
+{
+    if (!textureId) return;
+    
+    makeCurrent();
+    glDeleteTextures(1, &textureId);
+    textureId = 0;
+}
+
 void BaseRenderer::setOrthoProjection(float left, float right, float bottom, float top,
                                      float nearPlane, float farPlane)
 {
@@ -290,6 +313,38 @@ void BaseRenderer::setPerspectiveProjection(float fov, float aspect, float nearP
     update();
 }
 
+bool BaseRenderer::tick(float deltaTime)
+{
+    Q_UNUSED(deltaTime);
+    return false; // 默认没有动画，由调度器降为低频
+}
+
+void BaseRenderer::setSimulationPaused(bool paused)
+{
+    FrameScheduler::instance()->setPaused(this, paused);
+}
+
+bool BaseRenderer::isSimulationPaused() const
+{
+    return FrameScheduler::instance()->isPaused(const_cast<BaseRenderer*>(this));
+}
+
+void BaseRenderer::setPreloadedImages(const QHash<QString, QImage> &images)
+{
+    preloadedImages = images;
+}
+
+bool BaseRenderer::hasPreloadedImage(const QString &name) const
+{
+    return preloadedImages.contains(name);
+}
+
+QImage BaseRenderer::takePreloadedImage(const QString &name)
+{
+    // 上传后不再需要CPU端副本
+    return preloadedImages.take(name);
+}
+
 bool BaseRenderer::isKeyPressed(int key) const
 {
     return pressedKeys.contains(key);
@@ -298,6 +353,7 @@ bool BaseRenderer::isKeyPressed(int key) const
 void BaseRenderer::keyPressEvent(QKeyEvent *event)
 {
     pressedKeys.insert(event->key());
+    FrameScheduler::instance()->wake(this); // 有输入时恢复全速
     QOpenGLWidget::keyPressEvent(event);
 }
 
@@ -310,6 +366,7 @@ void BaseRenderer::keyReleaseEvent(QKeyEvent *event)
 void BaseRenderer::mousePressEvent(QMouseEvent *event)
 {
     mousePosition = QVector2D(event->pos());
+    FrameScheduler::instance()->wake(this);
     QOpenGLWidget::mousePressEvent(event);
 }
 
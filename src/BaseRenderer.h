@@ -19,8 +19,11 @@
 #include <QMouseEvent>
 
 #include <QSet>
+#include <QHash>
+#include <QImage>
 #include <functional>
 #include "ShaderManager.h"
+#include "FrameScheduler.h"
 
 class BaseRenderer : public QOpenGLWidget, protected QOpenGLFunctions
 {
@@ -70,6 +73,7 @@ public:
     // 相机控制接口
     void setCameraPosition(const QVector2D &position);
     void setCameraZoom(float zoom);
+    void setCameraZoomRange(float minZoom, float maxZoom);
     QVector2D getCameraPosition() const { return cameraPosition; }
     float getCameraZoom() const { return cameraZoom; }
 
@@ -77,10 +81,20 @@ public:
     void createQuadGeometry(float width = 1.0f, float height = 1.0f);
     void createTextureFromImage(const QImage &image, GLuint &textureId, 
                                GLenum minFilter = GL_LINEAR, GLenum magFilter = GL_LINEAR);
+    void deleteTexture(GLuint &textureId);
     
     // 输入状态
     bool isKeyPressed(int key) const;
     
+    // 模拟暂停（由FrameScheduler停止调用tick）
+    void setSimulationPaused(bool paused);
+    bool isSimulationPaused() const;
+    
+    // 预加载资源（可在后台线程解码，initializeGL时只做上传）
+    void setPreloadedImages(const QHash<QString, QImage> &images);
+    bool hasPreloadedImage(const QString &name) const;
+    QImage takePreloadedImage(const QString &name);
+    
 protected:
     // 虚函数
     virtual void initializeGL() override;
@@ -95,6 +109,9 @@ protected:
     virtual void updateViewMatrix();
     virtual void updateProjectionMatrix();
     
+    // 每帧由FrameScheduler调用，返回是否有变化（有变化时子类自行调用update()）
+    virtual bool tick(float deltaTime);
+    
     // 工具方法
     QOpenGLVertexArrayObject* getQuadVAO() { return &quadVAO; }
     QMatrix4x4 getProjectionMatrix() const { return projectionMatrix; }
@@ -103,6 +120,8 @@ protected:
     // 相机参数
     QVector2D cameraPosition = QVector2D(0.0f, 0.0f);
     float cameraZoom = 1.0f;
+    float minCameraZoom = 0.1f;
+    float maxCameraZoom = 10.0f;
     
     // 投影和视图矩阵
     QMatrix4x4 projectionMatrix;
@@ -113,6 +132,9 @@ protected:
     QSet<int> pressedKeys;
     QVector2D mousePosition;
     
+    // 预加载的图像
+    QHash<QString, QImage> preloadedImages;
+    
 private:
     // 几何体
     QOpenGLVertexArrayObject quadVAO;
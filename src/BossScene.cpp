@@ -16,11 +16,13 @@ BossScene::BossScene(QWidget *parent)
     : BaseRenderer(parent)
     , groundTexture(0)
     , brazierTexture(0)
+    , wallTexture(0)
     , groundLevel(-5.0f)
     , groundWidth(20.0f)
     , groundSegments(50)
     , bossLevel(1)
     , battleActive(true)
+    , hudOverlayEnabled(false)
 {
     // 设置相机初始位置
     setCameraPosition(QVector2D(0.0f, 0.0f));
@@ -72,10 +74,6 @@ BossScene::BossScene(QWidget *parent)
     boss.currentAnimation = "idle";
     boss.animationTime = 0.0f;
     
-    // 设置更新定时器
-    connect(&updateTimer, &QTimer::timeout, this, &BossScene::updateGame);
-    updateTimer.start(16); // ~60 FPS
-    
     // 初始化随机种子
     std::srand(std::time(nullptr));
 }
@@ -94,6 +92,20 @@ BossScene::~BossScene()
         brazierTexture = 0;
     }
     
+    if (wallTexture) {
+        glDeleteTextures(1, &wallTexture);
+        wallTexture = 0;
+    }
+    
+    hudLayer.releaseTexture(this);
+    
+    // Spine资源在最后一个骨骼释放时一并释放图集纹理
+    delete player.spine;
+    player.spine = nullptr;
+    delete boss.spine;
+    boss.spine = nullptr;
+    spineRenderer.release();
+    
     // 清理骨骼内存
     for (Bone* bone : player.bones) {
         delete bone;
@@ -125,6 +137,24 @@ void BossScene::setBossLevel(int level)
     boss.health = 200.0f + bossLevel * 50.0f;
     boss.maxHealth = boss.health;
     battleActive = true;
+    
+    // 新一局开始，恢复全速更新
+    FrameScheduler::instance()->wake(this);
+}
+
+void BossScene::setHudOverlayEnabled(bool enabled)
+{
+    if (hudOverlayEnabled == enabled) return;
+    hudOverlayEnabled = enabled;
+    update();
+}
+
+void BossScene::setHudValues(float health, float maxHealth, int score, int coins)
+{
+    hudLayer.setValues(health, maxHealth, score, coins);
+    if (hudOverlayEnabled && hudLayer.isDirty()) {
+        update();
+    }
 }
 
 void BossScene::initializeGL()
@@ -137,10 +167,56 @@ void BossScene::initializeGL()
     // 设置场景
     setupScene();
     
+    spineRenderer.initialize(this);
+    loadDefaultSkeletons();
+    
     gameTimer.start();
 }
 
-void BossScene::createTextures()
+bool BossScene::loadPlayerSkeleton(const QString &atlasPath, const QString &skeletonPath, float scale)
+{
+    return loadCharacterSkeleton(player, atlasPath, skeletonPath, scale);
+}
+
+bool BossScene::loadBossSkeleton(const QString &atlasPath, const QString &skeletonPath, float scale)
+{
+    return loadCharacterSkeleton(boss, atlasPath, skeletonPath, scale);
+}
+
+bool BossScene::loadCharacterSkeleton(Character &character, const QString &atlasPath,
+                                      const QString &skeletonPath, float scale)
+{
+    // 纹理在第一次绘制时才上传，这里不需要GL上下文
+    std::shared_ptr<SpineAsset> asset = SpineAsset::load(this, atlasPath, skeletonPath, scale);
+    if (!asset) {
+        return false;
+    }
+    
+    delete character.spine;
+    character.spine = new SpineActor(asset);
+    character.spine->setAnimation(character.currentAnimation);
+    update();
+    return true;
+}
+
+void BossScene::loadDefaultSkeletons()
+{
+    // 资源目录下有Spine导出文件时自动替换色块角色
+    auto tryLoad = [this](Character &character, const QString &name) {
+        QString base = "../assets/spine/" + name;
+        if (character.spine || !QFile::exists(base + ".atlas")) return;
+        
+        if (QFile::exists(base + ".skel")) {
+            loadCharacterSkeleton(character, base + ".atlas", base + ".skel", 0.005f);
+        } else if (QFile::exists(base + ".json")) {
+            loadCharacterSkeleton(character, base + ".atlas", base + ".json", 0.005f);
+        }
+    };
+    tryLoad(player, "player");
+    tryLoad(boss, "boss");
+}
+
+QImage BossScene::generateGroundImage()
 {
     // 生成地面纹理
     const int width = 512;
@@ -176,25 +252,55 @@ void BossScene::createTextures()
     }
     
     painter.end();
+    return texture;
+}
+
+QHash<QString, QImage> BossScene::loadResources(int level, const std::function<void(int)> &progress)
+{
+    Q_UNUSED(level); // 目前各关卡共用同一套资源
     
-    // 上传地面纹理到GPU
-    createTextureFromImage(texture, groundTexture, GL_LINEAR, GL_LINEAR);
+    QHash<QString, QImage> images;
     
-    // 加载火把纹理
+    images.insert("ground", generateGroundImage());
+    if (progress) progress(40);
+    
+    // 预先转换为上传格式，避免在GUI线程再次转换
     QString brazierPath = "../assets/brazier.png";
     if (QFile::exists(brazierPath)) {
-        QImage brazierImage(brazierPath);
-        createTextureFromImage(brazierImage, brazierTexture, GL_LINEAR, GL_LINEAR);
-        // debugTextureAlpha(brazierTexture, "brazier");
-        qDebug() << "Loaded brazier texture:" << brazierPath;
+        images.insert("brazier", QImage(brazierPath).convertToFormat(QImage::Format_RGBA8888));
     }
-
-    // 加载墙纹理
+    if (progress) progress(70);
+    
     QString wallPath = "../assets/wall.jpg";
     if (QFile::exists(wallPath)) {
-        QImage wallImage(wallPath);
-        createTextureFromImage(wallImage, wallTexture, GL_LINEAR, GL_LINEAR);
-        qDebug() << "Loaded wall texture:" << wallPath;
+        images.insert("wall", QImage(wallPath).convertToFormat(QImage::Format_RGBA8888));
+    }
+    if (progress) progress(100);
+    
+    return images;
+}
+
+void BossScene::createTextures()
+{
+    // 没有经过预加载时退回到同步解码
+    if (!hasPreloadedImage("ground")) {
+        setPreloadedImages(loadResources(bossLevel));
+    }
+    
+    // 上传地面纹理到GPU
+    createTextureFromImage(takePreloadedImage("ground"), groundTexture, GL_LINEAR, GL_LINEAR);
+    
+    // 火把纹理
+    if (hasPreloadedImage("brazier")) {
+        createTextureFromImage(takePreloadedImage("brazier"), brazierTexture, GL_LINEAR, GL_LINEAR);
+        // debugTextureAlpha(brazierTexture, "brazier");
+        qDebug() << "Loaded brazier texture";
+    }
+
+    // 墙纹理
+    if (hasPreloadedImage("wall")) {
+        createTextureFromImage(takePreloadedImage("wall"), wallTexture, GL_LINEAR, GL_LINEAR);
+        qDebug() << "Loaded wall texture";
     }
 }
 
@@ -286,9 +392,10 @@ void BossScene::renderScene()
     // 绘制地面
     drawGround();
     
-    // 绘制角色
+    // 绘制角色（Spine角色在这里统一提交）
     drawCharacter(player);
     drawCharacter(boss);
+    spineRenderer.flush(getProjectionMatrix(), getViewMatrix());
 
     drawForeground();
 
@@ -297,6 +404,9 @@ void BossScene::renderScene()
     
     // 绘制血条
     drawHealthBars();
+    
+    // 绘制HUD
+    drawHud();
 }
 
 void BossScene::drawBackground()
@@ -373,26 +483,34 @@ void BossScene::drawGround()
 
 void BossScene::drawCharacter(const Character &character)
 {
-    // 绘制身体
-    for (Bone* bone : character.bones) {
+    if (character.spine) {
+        // 骨骼原点在脚下，与角色位置对齐
         QMatrix4x4 model;
-        model.translate(character.position.x() + bone->position.x(), 
-                        character.position.y() + bone->position.y());
-        if (!character.facingRight) {
-            model.scale(-1.0f, 1.0f, 1.0f);
-        }
-        model.rotate(bone->rotation, 0.0f, 0.0f, 1.0f);
-        model.scale(bone->scale.x() * 0.5f, bone->scale.y() * 0.5f, 1.0f);
+        model.translate(character.position.x(), character.position.y());
+        model.scale(character.facingRight ? 1.0f : -1.0f, 1.0f, 1.0f);
+        spineRenderer.draw(character.spine->skeleton(), model);
+    } else {
+        // 绘制身体
+        for (Bone* bone : character.bones) {
+            QMatrix4x4 model;
+            model.translate(character.position.x() + bone->position.x(), 
+                            character.position.y() + bone->position.y());
+            if (!character.facingRight) {
+                model.scale(-1.0f, 1.0f, 1.0f);
+            }
+            model.rotate(bone->rotation, 0.0f, 0.0f, 1.0f);
+            model.scale(bone->scale.x() * 0.5f, bone->scale.y() * 0.5f, 1.0f);
         
-        // 设置颜色
-        QVector3D charColor;
-        if (&character == &player) {
-            charColor = QVector3D(0.4f, 0.6f, 1.0f); // 蓝色玩家
-        } else {
-            charColor = QVector3D(1.0f, 0.4f, 0.4f); // 红色Boss
-        }
+            // 设置颜色
+            QVector3D charColor;
+            if (&character == &player) {
+                charColor = QVector3D(0.4f, 0.6f, 1.0f); // 蓝色玩家
+            } else {
+                charColor = QVector3D(1.0f, 0.4f, 0.4f); // 红色Boss
+            }
         
-        renderColoredQuad(model, charColor, 1.0f, "simple");
+            renderColoredQuad(model, charColor, 1.0f, "simple");
+        }
     }
     
     // 绘制状态效果
@@ -478,12 +596,33 @@ void BossScene::drawHealthBars()
     renderColoredQuad(bossHealth, healthColor, 1.0f, "simple");
 }
 
-void BossScene::updateGame()
+void BossScene::drawHud()
 {
-    if (!battleActive) return;
+    if (!hudOverlayEnabled) return;
+    
+    // 与血条相同的方式固定在相机上方
+    QVector2D cameraPos = getCameraPosition();
+    float hudWidth = 6.0f;
+    float hudHeight = hudWidth / hudLayer.aspectRatio();
+    
+    QMatrix4x4 model;
+    model.translate(cameraPos.x(), cameraPos.y() + 4.5f, 0.5f);
+    model.scale(hudWidth, hudHeight, 1.0f);
     
-    float deltaTime = 0.016f; // 假设60FPS
+    hudLayer.render(this, model);
+}
+
+bool BossScene::tick(float deltaTime)
+{
+    // 战斗结束后没有变化，调度器会降为低频
+    if (!battleActive) return false;
     
+    updateGame(deltaTime);
+    return true;
+}
+
+void BossScene::updateGame(float deltaTime)
+{
     // 更新物理
     updatePhysics(deltaTime);
     
@@ -563,6 +702,14 @@ void BossScene::updateAnimations(float deltaTime)
     player.animationTime += deltaTime;
     boss.animationTime += deltaTime;
     
+    spineActors.clear();
+    for (Character *character : {&player, &boss}) {
+        if (!character->spine) continue;
+        selectSpineAnimation(*character);
+        spineActors.push_back(character->spine);
+    }
+    spineUpdater.update(spineActors, deltaTime);
+    
     // 更新骨骼动画（简化版）
     for (Bone* bone : player.bones) {
         if (bone->name == "body") {
@@ -580,6 +727,22 @@ void BossScene::updateAnimations(float deltaTime)
     }
 }
 
+void BossScene::selectSpineAnimation(Character &character)
+{
+    // 按运动状态选动画，骨骼里没有对应动画时退回idle
+    QString wanted = "idle";
+    if (!character.isGrounded) {
+        wanted = "jump";
+    } else if (std::abs(character.velocity.x()) > 0.5f) {
+        wanted = "run";
+    }
+    if (character.spine->setAnimation(wanted)) {
+        character.currentAnimation = wanted;
+    } else if (character.spine->setAnimation("idle")) {
+        character.currentAnimation = "idle";
+    }
+}
+
 void BossScene::checkCollisions()
 {
     // 简单的碰撞检测
@@ -613,6 +776,11 @@ void BossScene::keyPressEvent(QKeyEvent *event)
         
         player.hitboxes.append(attack);
     }
+
+    // 调试：输出Spine内存按分配位置的统计
+    if (event->key() == Qt::Key_F9 && SpineAllocator::instance()) {
+        SpineAllocator::instance()->dumpStatistics();
+    }
 }
 
 void BossScene::keyReleaseEvent(QKeyEvent *event)
@@ -2,6 +2,10 @@
 #define BOSSSCENE_H
 
 #include "BaseRenderer.h"
+#include "HudLayer.h"
+#include "SpineRenderer.h"
+#include "SpineUpdateScheduler.h"
+#include <functional>
 
 // 简单的骨骼动画结构
 struct Bone {
@@ -42,6 +46,7 @@ struct Character {
     QVector<Status*> statuses;
     QString currentAnimation;
     float animationTime;
+    SpineActor* spine = nullptr;    // 非空时用Spine骨骼代替色块
 };
 
 class BossScene : public BaseRenderer
@@ -54,6 +59,19 @@ public:
     
     void setBossLevel(int level);
     
+    // GL HUD层（替代叠加在GL控件上的QLabel）
+    void setHudOverlayEnabled(bool enabled);
+    bool isHudOverlayEnabled() const { return hudOverlayEnabled; }
+    void setHudValues(float health, float maxHealth, int score, int coins);
+    
+    // 把角色换成Spine骨骼（skeletonPath为.json或.skel），scale把像素换算到场景单位
+    bool loadPlayerSkeleton(const QString &atlasPath, const QString &skeletonPath, float scale = 0.005f);
+    bool loadBossSkeleton(const QString &atlasPath, const QString &skeletonPath, float scale = 0.005f);
+    
+    // 解码场景所需的图像资源，不涉及OpenGL，可在后台线程调用
+    static QHash<QString, QImage> loadResources(int level,
+                                                const std::function<void(int)> &progress = nullptr);
+    
 signals:
     void battleWon();
     void battleLost();
@@ -68,10 +86,11 @@ protected:
     void keyReleaseEvent(QKeyEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     
-private slots:
-    void updateGame();
+    // 由FrameScheduler驱动
+    bool tick(float deltaTime) override;
     
 private:
+    void updateGame(float deltaTime);
     void setupScene();
     void updatePhysics(float deltaTime);
     void checkCollisions();
@@ -81,8 +100,13 @@ private:
     void drawMidground();
     void drawForeground();
     void drawCharacter(const Character &character);
+    bool loadCharacterSkeleton(Character &character, const QString &atlasPath,
+                               const QString &skeletonPath, float scale);
+    void loadDefaultSkeletons();
+    void selectSpineAnimation(Character &character);
     void drawHitboxes();
     void drawHealthBars();
+    void drawHud();
     void drawGround();
     
     // 游戏对象
@@ -109,12 +133,22 @@ private:
     int bossLevel;
     bool battleActive;
     QElapsedTimer gameTimer;
-    QTimer updateTimer;
+    
+    // Spine骨骼绘制（每帧一次上传）
+    SpineRenderer spineRenderer;
+    // Spine骨骼的动画和世界变换更新（实例多时并行）
+    SpineUpdateScheduler spineUpdater;
+    std::vector<SpineActor*> spineActors;
+    
+    // HUD层
+    HudLayer hudLayer;
+    bool hudOverlayEnabled;
     
     // 前景火把位置
     QVector<QVector2D> brazierPositions;
     
     void createTextures();
+    static QImage generateGroundImage();
 
 
     void debugTextureAlpha(GLuint textureId, const QString& name);
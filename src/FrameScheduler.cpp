@@ -0,0 +1,217 @@
+#include "FrameScheduler.h"
+#include <QGuiApplication>
+#include <QEvent>
+#include <QDebug>
+
+namespace {
+// 连续多少帧无变化后进入空闲（低频）模式
+const int kIdleFrameThreshold = 30;
+// 恢复运行时避免过大的时间步长
+const float kMaxDeltaTime = 0.1f;
+}
+
+FrameScheduler* FrameScheduler::m_instance = nullptr;
+
+FrameScheduler::FrameScheduler(QObject *parent)
+    : QObject(parent)
+    , activeIntervalMs(16)   // ~60 FPS
+    , idleIntervalMs(250)    // 空闲时 4 FPS
+    , inFrame(false)
+{
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&frameTimer, &QTimer::timeout, this, &FrameScheduler::onFrame);
+
+    // 应用被隐藏/挂起时整体停止
+    if (auto *app = qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        connect(app, &QGuiApplication::applicationStateChanged, this, &FrameScheduler::reschedule);
+    }
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    frameTimer.stop();
+}
+
+FrameScheduler* FrameScheduler::instance()
+{
+    // 只在GUI线程使用，不需要加锁
+    if (!m_instance) {
+        m_instance = new FrameScheduler();
+    }
+    return m_instance;
+}
+
+void FrameScheduler::registerClient(QWidget *widget, TickFunction tick)
+{
+    Client client;
+    client.widget = widget;
+    client.tick = std::move(tick);
+    client.clock.start();
+
+    // 监听显示/隐藏以及窗口最小化
+    widget->installEventFilter(this);
+    if (widget->window() != widget) {
+        client.window = widget->window();
+        client.window->installEventFilter(this);
+    }
+    clients.insert(widget, client);
+
+    reschedule();
+}
+
+void FrameScheduler::unregisterClient(QWidget *widget)
+{
+    auto it = clients.find(widget);
+    if (it == clients.end()) return;
+
+    QPointer<QWidget> window = it->window;
+    clients.erase(it);
+
+    widget->removeEventFilter(this);
+    // 同一窗口下可能还有其他场景，最后一个注销时才移除窗口上的过滤器
+    if (window) {
+        bool shared = false;
+        for (const Client &client : clients) {
+            if (client.window == window) {
+                shared = true;
+                break;
+            }
+        }
+        if (!shared) window->removeEventFilter(this);
+    }
+    reschedule();
+}
+
+void FrameScheduler::setPaused(QWidget *widget, bool paused)
+{
+    auto it = clients.find(widget);
+    if (it == clients.end() || it->paused == paused) return;
+
+    it->paused = paused;
+    it->idleFrames = 0;
+    it->clock.restart();
+    reschedule();
+}
+
+bool FrameScheduler::isPaused(QWidget *widget) const
+{
+    auto it = clients.constFind(widget);
+    return it != clients.constEnd() && it->paused;
+}
+
+void FrameScheduler::wake(QWidget *widget)
+{
+    auto it = clients.find(widget);
+    if (it == clients.end()) return;
+
+    if (isIdle(*it)) {
+        it->idleFrames = 0;
+        reschedule();
+    }
+}
+
+void FrameScheduler::setActiveInterval(int msec)
+{
+    activeIntervalMs = qMax(1, msec);
+    reschedule();
+}
+
+void FrameScheduler::setIdleInterval(int msec)
+{
+    idleIntervalMs = qMax(activeIntervalMs, msec);
+    reschedule();
+}
+
+bool FrameScheduler::isSuspended(const Client &client) const
+{
+    if (client.paused || !client.widget) return true;
+
+    // 隐藏或最小化的场景既不模拟也不渲染
+    if (!client.widget->isVisible() || client.widget->window()->isMinimized()) return true;
+
+    Qt::ApplicationState state = QGuiApplication::applicationState();
+    return state == Qt::ApplicationHidden || state == Qt::ApplicationSuspended;
+}
+
+bool FrameScheduler::isIdle(const Client &client) const
+{
+    return client.idleFrames >= kIdleFrameThreshold;
+}
+
+bool FrameScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+        // 等事件处理完毕后再重新计算，此时可见状态已更新
+        QMetaObject::invokeMethod(this, &FrameScheduler::reschedule, Qt::QueuedConnection);
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void FrameScheduler::onFrame()
+{
+    // tick中可能弹出模态对话框，防止重入
+    if (inFrame) return;
+    inFrame = true;
+
+    // tick可能注销客户端，先复制键
+    const QList<QWidget*> keys = clients.keys();
+    for (QWidget *key : keys) {
+        auto it = clients.find(key);
+        if (it == clients.end() || isSuspended(*it)) continue;
+
+        qint64 elapsed = it->clock.elapsed();
+        // 空闲客户端按低频运行（留出半帧余量抵消定时器抖动）
+        if (isIdle(*it) && elapsed < idleIntervalMs - activeIntervalMs / 2) continue;
+        it->clock.restart();
+
+        float deltaTime = qMin(elapsed / 1000.0f, kMaxDeltaTime);
+        TickFunction tick = it->tick;
+        bool changed = tick(deltaTime);
+
+        // 回调后迭代器可能失效，重新查找
+        it = clients.find(key);
+        if (it == clients.end()) continue;
+        it->idleFrames = changed ? 0 : qMin(it->idleFrames + 1, kIdleFrameThreshold);
+    }
+
+    inFrame = false;
+    reschedule();
+}
+
+void FrameScheduler::reschedule()
+{
+    bool anyActive = false;
+    bool anyIdle = false;
+
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        if (isSuspended(*it)) continue;
+        if (isIdle(*it)) {
+            anyIdle = true;
+        } else {
+            anyActive = true;
+        }
+    }
+
+    int interval = anyActive ? activeIntervalMs : (anyIdle ? idleIntervalMs : -1);
+    if (interval < 0) {
+        // 没有需要运行的场景，完全停止定时器
+        frameTimer.stop();
+        return;
+    }
+
+    if (!frameTimer.isActive() || frameTimer.interval() != interval) {
+        // 从挂起恢复时重置计时，避免一次性补帧
+        if (!frameTimer.isActive()) {
+            for (auto it = clients.begin(); it != clients.end(); ++it) {
+                it->clock.restart();
+            }
+        }
+        frameTimer.start(interval);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QObject>
+#include <QWidget>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QHash>
+#include <functional>
+
+// 全局帧调度器：所有场景注册到这里，由一个定时器统一驱动
+// 暂停、隐藏或最小化时不再调用场景的tick；连续无变化时降为低频刷新
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 返回true表示本帧有变化（场景自行调用update()）
+    using TickFunction = std::function<bool(float deltaTime)>;
+
+    static FrameScheduler* instance();
+
+    void registerClient(QWidget *widget, TickFunction tick);
+    void unregisterClient(QWidget *widget);
+
+    void setPaused(QWidget *widget, bool paused);
+    bool isPaused(QWidget *widget) const;
+
+    // 有输入或外部状态变化时恢复全速
+    void wake(QWidget *widget);
+
+    void setActiveInterval(int msec);
+    void setIdleInterval(int msec);
+    int activeInterval() const { return activeIntervalMs; }
+    int idleInterval() const { return idleIntervalMs; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onFrame();
+    void reschedule();
+
+private:
+    FrameScheduler(QObject *parent = nullptr);
+    ~FrameScheduler();
+
+    struct Client {
+        QPointer<QWidget> widget;
+        QPointer<QWidget> window;    // 安装了事件过滤器的顶层窗口，注销时从同一对象移除
+        TickFunction tick;
+        bool paused = false;
+        int idleFrames = 0;      // 连续无变化的帧数
+        QElapsedTimer clock;
+    };
+
+    bool isSuspended(const Client &client) const;
+    bool isIdle(const Client &client) const;
+
+    static FrameScheduler* m_instance;
+
+    QHash<QWidget*, Client> clients;
+    QTimer frameTimer;
+    int activeIntervalMs;
+    int idleIntervalMs;
+    bool inFrame;
+};
+
+#endif // FRAMESCHEDULER_H
@@ -15,31 +15,24 @@ GameScreen::GameScreen(QWidget *parent)
     , playerMaxHealth(100.0f)
     , playerScore(0)
     , playerCoins(0)
+    , sceneManager(nullptr)
     , bossScene(nullptr)
     // , combatScene(nullptr)
     // , shopScene(nullptr)
     , currentSceneWidget(nullptr)
+    , hudState(nullptr)
+    , glHudEnabled(true)
 {
     setupUI();
     setupHUD();
     setupControlPanel();
     setupSceneManager();
-    
-    // 初始化HUD更新定时器
-    hudUpdateTimer = new QTimer(this);
-    connect(hudUpdateTimer, &QTimer::timeout, this, &GameScreen::updateHUD);
-    hudUpdateTimer->start(100); // 每100ms更新一次HUD
 }
 
 GameScreen::~GameScreen()
 {
     // 清理场景
     unloadCurrentScene();
-    
-    if (hudUpdateTimer) {
-        hudUpdateTimer->stop();
-        hudUpdateTimer->deleteLater();
-    }
 }
 
 void GameScreen::setupUI()
@@ -148,6 +141,21 @@ void GameScreen::setupHUD()
     scoreLabel->setFont(font);
     coinsLabel->setFont(font);
     sceneLabel->setFont(font);
+    
+    // 事件驱动的HUD：数值变化时才更新，取代定时轮询
+    hudState = new HudState(this);
+    hudState->setHealth(playerHealth, playerMaxHealth);
+    hudState->setScore(playerScore);
+    hudState->setCoins(playerCoins);
+    
+    connect(this, &GameScreen::playerHealthChanged, hudState, [this](float health) {
+        hudState->setHealth(health, playerMaxHealth);
+    });
+    connect(this, &GameScreen::playerScoreChanged, hudState, &HudState::setScore);
+    connect(this, &GameScreen::playerCoinsChanged, hudState, &HudState::setCoins);
+    connect(hudState, &HudState::changed, this, &GameScreen::updateHUD);
+    
+    hudState->flush();
 }
 
 void GameScreen::setupControlPanel()
@@ -157,8 +165,17 @@ void GameScreen::setupControlPanel()
 
 void GameScreen::setupSceneManager()
 {
-    // 初始化场景管理器
-    // 可以添加场景预加载等逻辑
+    // 初始化场景管理器，场景实例挂在sceneStack下并被缓存复用
+    sceneManager = new SceneManager(sceneStack, this);
+    
+    connect(sceneManager, &SceneManager::sceneCreated, this, &GameScreen::onSceneCreated);
+    connect(sceneManager, &SceneManager::sceneReady, this, &GameScreen::onSceneReady);
+    connect(sceneManager, &SceneManager::loadProgress, this, &GameScreen::onSceneLoadProgress);
+}
+
+void GameScreen::preloadScene(GameSceneType sceneType, int level)
+{
+    sceneManager->preload(sceneType, level);
 }
 
 void GameScreen::loadScene(GameSceneType sceneType, int level)
@@ -174,9 +191,10 @@ void GameScreen::loadScene(GameSceneType sceneType, int level)
         break;
         
     case GameSceneType::BOSS_BATTLE:
-        createBossScene(level);
-        sceneLabel->setText(QString("Scene: Boss Battle (Level %1)").arg(level));
-        break;
+        // 资源就绪后在onSceneReady中切换
+        sceneLabel->setText(QString("Scene: Loading Boss Battle (Level %1)...").arg(level));
+        sceneManager->request(sceneType, level);
+        return;
     case GameSceneType::SHOP:
         break;
         
@@ -190,11 +208,45 @@ void GameScreen::loadScene(GameSceneType sceneType, int level)
         return;
     }
     
+    // 恢复游戏状态
+    if (gamePaused) {
+        resumeGame();
+    }
+}
+
+void GameScreen::onSceneLoadProgress(GameSceneType type, int percent)
+{
+    if (type != currentSceneType || currentSceneWidget) return;
+    
+    if (type == GameSceneType::BOSS_BATTLE) {
+        sceneLabel->setText(QString("Scene: Loading Boss Battle (Level %1)... %2%")
+            .arg(currentLevel).arg(percent));
+    }
+}
+
+void GameScreen::onSceneReady(GameSceneType type, int level, QWidget *scene)
+{
+    // 加载期间已切换到其他场景，忽略过期的结果
+    if (type != currentSceneType || level != currentLevel || currentSceneWidget) return;
+    
+    switch (type) {
+    case GameSceneType::BOSS_BATTLE:
+        bossScene->setBossLevel(level);
+        sceneLabel->setText(QString("Scene: Boss Battle (Level %1)").arg(level));
+        break;
+    default:
+        break;
+    }
+    
     // 显示场景
-    if (currentSceneWidget) {
-        sceneStack->setCurrentWidget(currentSceneWidget);
-        emit sceneChanged(sceneType);
+    currentSceneWidget = scene;
+    if (sceneStack->indexOf(scene) < 0) {
+        sceneStack->addWidget(scene);
     }
+    scene->setVisible(true);
+    sceneStack->setCurrentWidget(scene);
+    applyHudMode();
+    emit sceneChanged(type);
     
     // 恢复游戏状态
     if (gamePaused) {
@@ -204,15 +256,17 @@ void GameScreen::loadScene(GameSceneType sceneType, int level)
 
 void GameScreen::unloadCurrentScene()
 {
+    if (currentSceneType != GameSceneType::NONE) {
+        sceneManager->cancelRequest(currentSceneType);
+    }
+    
     if (!currentSceneWidget) return;
     
     // 根据场景类型进行清理
     switch (currentSceneType) {
     case GameSceneType::BOSS_BATTLE:
         if (bossScene) {
-            // 断开所有连接
-            bossScene->disconnect();
-            // 停止更新
+            // 隐藏后帧调度器不再驱动（场景实例保留在缓存中，信号连接保持不变）
             bossScene->setVisible(false);
         }
         break;
@@ -224,57 +278,64 @@ void GameScreen::unloadCurrentScene()
     // 从堆栈中移除
     sceneStack->removeWidget(currentSceneWidget);
     currentSceneWidget = nullptr;
+    applyHudMode();
 }
 
-void GameScreen::createBossScene(int level)
+void GameScreen::onSceneCreated(GameSceneType type, QWidget *scene)
 {
-    if (!bossScene) {
-        bossScene = new BossScene(this);
-        
-        // 连接Boss场景信号
-        connect(bossScene, &BossScene::battleWon, this, [this, level]() {
-            int reward = level * 100;
-            playerScore += reward;
-            playerCoins += reward / 5;
-            
-            emit playerScoreChanged(playerScore);
-            emit playerCoinsChanged(playerCoins);
-            
-            QMessageBox::information(this, "Victory!", 
-                QString("Boss Defeated!\nReward: %1 points, %2 coins\nNew Level: %3")
-                .arg(reward).arg(reward / 5).arg(currentLevel));
-            
-            emit gameOver(true);
-        });
+    switch (type) {
+    case GameSceneType::BOSS_BATTLE:
+        bossScene = qobject_cast<BossScene*>(scene);
+        connectBossScene(bossScene);
+        bossScene->setHudValues(hudState->health(), hudState->maxHealth(),
+                                hudState->score(), hudState->coins());
+        break;
+    default:
+        break;
+    }
+}
+
+void GameScreen::connectBossScene(BossScene *scene)
+{
+    // 场景会被缓存复用，只在创建时连接一次
+    connect(scene, &BossScene::battleWon, this, [this]() {
+        int reward = currentLevel * 100;
+        playerScore += reward;
+        playerCoins += reward / 5;
         
-        connect(bossScene, &BossScene::battleLost, this, [this]() {
-            playerHealth -= 30.0f; // Boss战失败扣除更多生命值
-            if (playerHealth <= 0) {
-                playerHealth = 0;
-                onGameOver(false);
-            } else {
-                QMessageBox::information(this, "Defeat", 
-                    "You were defeated by the boss!");
-            }
-            emit playerHealthChanged(playerHealth);
-        });
+        emit playerScoreChanged(playerScore);
+        emit playerCoinsChanged(playerCoins);
         
-        // connect(bossScene, &BossScene::playerHealthUpdated, this, 
-        //         [this](float health) {
-        //     playerHealth = health;
-        //     emit playerHealthChanged(playerHealth);
-        // });
+        QMessageBox::information(this, "Victory!", 
+            QString("Boss Defeated!\nReward: %1 points, %2 coins\nNew Level: %3")
+            .arg(reward).arg(reward / 5).arg(currentLevel));
         
-        // connect(bossScene, &BossScene::scoreUpdated, this, 
-        //         [this](int score) {
-        //     playerScore += score;
-        //     emit playerScoreChanged(playerScore);
-        // });
-    }
+        emit gameOver(true);
+    });
     
-    bossScene->setBossLevel(level);
-    currentSceneWidget = bossScene;
-    sceneStack->addWidget(bossScene);
+    connect(scene, &BossScene::battleLost, this, [this]() {
+        playerHealth -= 30.0f; // Boss战失败扣除更多生命值
+        if (playerHealth <= 0) {
+            playerHealth = 0;
+            onGameOver(false);
+        } else {
+            QMessageBox::information(this, "Defeat", 
+                "You were defeated by the boss!");
+        }
+        emit playerHealthChanged(playerHealth);
+    });
+    
+    // connect(scene, &BossScene::playerHealthUpdated, this, 
+    //         [this](float health) {
+    //     playerHealth = health;
+    //     emit playerHealthChanged(playerHealth);
+    // });
+    
+    // connect(scene, &BossScene::scoreUpdated, this, 
+    //         [this](int score) {
+    //     playerScore += score;
+    //     emit playerScoreChanged(playerScore);
+    // });
 }
 
 void GameScreen::pauseGame()
@@ -284,7 +345,11 @@ void GameScreen::pauseGame()
     // 暂停当前场景
     switch (currentSceneType) {
     case GameSceneType::BOSS_BATTLE:
-        if (bossScene) bossScene->setUpdatesEnabled(false);
+        if (bossScene) {
+            // 停止模拟和重绘
+            bossScene->setSimulationPaused(true);
+            bossScene->setUpdatesEnabled(false);
+        }
         break;
     case GameSceneType::COMBAT:
         // if (combatScene) combatScene->setUpdatesEnabled(false);
@@ -301,7 +366,10 @@ void GameScreen::resumeGame()
     // 恢复当前场景
     switch (currentSceneType) {
     case GameSceneType::BOSS_BATTLE:
-        if (bossScene) bossScene->setUpdatesEnabled(true);
+        if (bossScene) {
+            bossScene->setUpdatesEnabled(true);
+            bossScene->setSimulationPaused(false);
+        }
         break;
     case GameSceneType::COMBAT:
 
@@ -332,16 +400,53 @@ void GameScreen::setPlayerCoins(int coins)
     emit playerCoinsChanged(playerCoins);
 }
 
-void GameScreen::updateHUD()
+void GameScreen::updateHUD(HudState::Fields fields)
 {
-    if (!gamePaused) {
-        // 更新HUD显示
-        healthLabel->setText(QString("Health: %1/%2")
-            .arg(static_cast<int>(playerHealth))
-            .arg(static_cast<int>(playerMaxHealth)));
-        
-        scoreLabel->setText(QString("Score: %1").arg(playerScore));
-        coinsLabel->setText(QString("Coins: %1").arg(playerCoins));
+    // 只更新变化的标签，文字相同时不调用setText
+    auto setLabelText = [](QLabel *label, const QString &text) {
+        if (label->text() != text) {
+            label->setText(text);
+        }
+    };
+    
+    if (fields & HudState::Health) {
+        setLabelText(healthLabel, QString("Health: %1/%2")
+            .arg(static_cast<int>(hudState->health()))
+            .arg(static_cast<int>(hudState->maxHealth())));
+    }
+    if (fields & HudState::Score) {
+        setLabelText(scoreLabel, QString("Score: %1").arg(hudState->score()));
+    }
+    if (fields & HudState::Coins) {
+        setLabelText(coinsLabel, QString("Coins: %1").arg(hudState->coins()));
+    }
+    
+    // 同步到GL HUD层
+    if (bossScene) {
+        bossScene->setHudValues(hudState->health(), hudState->maxHealth(),
+                                hudState->score(), hudState->coins());
+    }
+}
+
+void GameScreen::setGlHudEnabled(bool enabled)
+{
+    if (glHudEnabled == enabled) return;
+    glHudEnabled = enabled;
+    applyHudMode();
+}
+
+void GameScreen::applyHudMode()
+{
+    // Boss战中由GL层绘制数值，隐藏对应的QLabel
+    bool useGlHud = glHudEnabled && bossScene &&
+                    currentSceneType == GameSceneType::BOSS_BATTLE && currentSceneWidget;
+    
+    healthLabel->setVisible(!useGlHud);
+    scoreLabel->setVisible(!useGlHud);
+    coinsLabel->setVisible(!useGlHud);
+    
+    if (bossScene) {
+        bossScene->setHudOverlayEnabled(useGlHud);
     }
 }
 
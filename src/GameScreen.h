@@ -9,18 +9,11 @@
 #include <QLabel>
 #include <QTimer>
 #include "BossScene.h"
+#include "SceneManager.h"
+#include "HudState.h"
 // #include "CombatScene.h" 
 // #include "ShopScene.h"  
 
-enum class GameSceneType {
-    NONE,
-    COMBAT,
-    PLATFORMER,
-    BOSS_BATTLE,
-    SHOP,
-    MENU
-};
-
 class GameScreen : public QWidget
 {
     Q_OBJECT
@@ -31,6 +24,7 @@ public:
     
     // 场景控制方法
     void loadScene(GameSceneType sceneType, int level = 1);
+    void preloadScene(GameSceneType sceneType, int level = 1);
     void unloadCurrentScene();
     void pauseGame();
     void resumeGame();
@@ -48,6 +42,10 @@ public:
     int getPlayerScore() const { return playerScore; }
     int getPlayerCoins() const { return playerCoins; }
     
+    // 战斗中使用GL绘制的HUD代替QLabel
+    void setGlHudEnabled(bool enabled);
+    bool isGlHudEnabled() const { return glHudEnabled; }
+    
 signals:
     void gamePausedChanged(bool paused);
     void sceneChanged(GameSceneType newScene);
@@ -62,8 +60,11 @@ public slots:
     void onReturnToMap();
     
 private slots:
-    void updateHUD();
+    void updateHUD(HudState::Fields fields);
     void onSceneChangeRequested(GameSceneType newScene, int level = 1);
+    void onSceneCreated(GameSceneType type, QWidget *scene);
+    void onSceneReady(GameSceneType type, int level, QWidget *scene);
+    void onSceneLoadProgress(GameSceneType type, int percent);
     
 private:
     void setupUI();
@@ -71,7 +72,8 @@ private:
     void setupControlPanel();
     void setupSceneManager();
     // void createCombatScene(int level);
-    void createBossScene(int level);
+    void connectBossScene(BossScene *scene);
+    void applyHudMode();
     // void createShopScene(int level);
     
     // UI元素
@@ -86,6 +88,7 @@ private:
     
     QWidget *controlPanel;
     QStackedWidget *sceneStack;
+    SceneManager *sceneManager;
     
     // 游戏场景
     BossScene *bossScene;
@@ -104,8 +107,9 @@ private:
     int playerScore;
     int playerCoins;
     
-    // 定时器
-    QTimer *hudUpdateTimer;
+    // HUD数据（按帧合并后发布变化）
+    HudState *hudState;
+    bool glHudEnabled;
 };
 
 #endif // GAMESCREEN_H
\ No newline at end of file
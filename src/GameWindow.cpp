@@ -43,6 +43,9 @@ void GameWindow::setupUI()
 void GameWindow::startGame()
 {
     stackedWidget->setCurrentIndex(1);  // 切换到地图
+    
+    // 地图显示期间在后台预加载Boss场景
+    gameScreen->preloadScene(GameSceneType::BOSS_BATTLE, 1);
 }
 
 void GameWindow::showSettings()
@@ -0,0 +1,80 @@
+#include "HudLayer.h"
+#include "BaseRenderer.h"
+#include <QPainter>
+#include <QFont>
+#include <QFontDatabase>
+
+namespace {
+const int kHudTextureWidth = 512;
+const int kHudTextureHeight = 64;
+}
+
+HudLayer::HudLayer()
+    : health(0)
+    , maxHealth(0)
+    , score(0)
+    , coins(0)
+    , dirty(true)
+    , texture(0)
+{
+}
+
+void HudLayer::setValues(float newHealth, float newMaxHealth, int newScore, int newCoins)
+{
+    int h = static_cast<int>(newHealth);
+    int mh = static_cast<int>(newMaxHealth);
+    if (h == health && mh == maxHealth && newScore == score && newCoins == coins) {
+        return;
+    }
+
+    health = h;
+    maxHealth = mh;
+    score = newScore;
+    coins = newCoins;
+    dirty = true;
+}
+
+float HudLayer::aspectRatio() const
+{
+    return static_cast<float>(kHudTextureWidth) / kHudTextureHeight;
+}
+
+QImage HudLayer::rasterize() const
+{
+    QImage image(kHudTextureWidth, kHudTextureHeight, QImage::Format_RGBA8888);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.fillRect(image.rect(), QColor(0, 0, 0, 140));
+
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setPixelSize(kHudTextureHeight / 2);
+    font.setBold(true);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+
+    QString text = QString("HP %1/%2   Score %3   Coins %4")
+        .arg(health).arg(maxHealth).arg(score).arg(coins);
+    painter.drawText(image.rect(), Qt::AlignCenter, text);
+    painter.end();
+
+    return image;
+}
+
+void HudLayer::render(BaseRenderer *renderer, const QMatrix4x4 &modelMatrix)
+{
+    // 只有数值变化时才重新上传纹理
+    if (dirty || !texture) {
+        renderer->createTextureFromImage(rasterize(), texture, GL_LINEAR, GL_LINEAR);
+        dirty = false;
+    }
+
+    renderer->renderTexturedQuad(modelMatrix, texture, QVector4D(1.0f, 1.0f, 1.0f, 1.0f), "texture");
+}
+
+void HudLayer::releaseTexture(BaseRenderer *renderer)
+{
+    renderer->deleteTexture(texture);
+    dirty = true;
+}
@@ -0,0 +1,38 @@
+#ifndef HUDLAYER_H
+#define HUDLAYER_H
+
+#include <QOpenGLFunctions>
+#include <QMatrix4x4>
+#include <QImage>
+
+class BaseRenderer;
+
+// 在OpenGL中绘制的HUD层：数值变化时才重新光栅化文字并上传纹理
+class HudLayer
+{
+public:
+    HudLayer();
+
+    void setValues(float health, float maxHealth, int score, int coins);
+    bool isDirty() const { return dirty; }
+
+    // 必须在渲染器的GL上下文中调用
+    void render(BaseRenderer *renderer, const QMatrix4x4 &modelMatrix);
+    void releaseTexture(BaseRenderer *renderer);
+
+    // 纹理宽高比，用于计算四边形尺寸
+    float aspectRatio() const;
+
+private:
+    QImage rasterize() const;
+
+    int health;
+    int maxHealth;
+    int score;
+    int coins;
+
+    bool dirty;
+    GLuint texture;
+};
+
+#endif // HUDLAYER_H
@@ -0,0 +1,52 @@
+#include "HudState.h"
+
+HudState::HudState(QObject *parent)
+    : QObject(parent)
+{
+    // 一帧（约16ms）内的修改合并成一次发布
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(16);
+    connect(&flushTimer, &QTimer::timeout, this, &HudState::flush);
+}
+
+void HudState::setHealth(float health, float maxHealth)
+{
+    // HUD只显示整数，小数变化不触发刷新
+    bool changedValue = static_cast<int>(health) != static_cast<int>(currentHealth) ||
+                        static_cast<int>(maxHealth) != static_cast<int>(currentMaxHealth);
+    currentHealth = health;
+    currentMaxHealth = maxHealth;
+    if (changedValue) markDirty(Health);
+}
+
+void HudState::setScore(int score)
+{
+    if (score == currentScore) return;
+    currentScore = score;
+    markDirty(Score);
+}
+
+void HudState::setCoins(int coins)
+{
+    if (coins == currentCoins) return;
+    currentCoins = coins;
+    markDirty(Coins);
+}
+
+void HudState::markDirty(Fields fields)
+{
+    dirtyFields |= fields;
+    if (!flushTimer.isActive()) {
+        flushTimer.start();
+    }
+}
+
+void HudState::flush()
+{
+    flushTimer.stop();
+    if (!dirtyFields) return;
+
+    Fields fields = dirtyFields;
+    dirtyFields = NoField;
+    emit changed(fields);
+}
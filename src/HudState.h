@@ -0,0 +1,54 @@
+#ifndef HUDSTATE_H
+#define HUDSTATE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QFlags>
+
+// HUD数据：合并同一帧内的多次修改，每帧最多发布一次变化
+class HudState : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Field {
+        NoField = 0x0,
+        Health  = 0x1,
+        Score   = 0x2,
+        Coins   = 0x4
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    explicit HudState(QObject *parent = nullptr);
+
+    float health() const { return currentHealth; }
+    float maxHealth() const { return currentMaxHealth; }
+    int score() const { return currentScore; }
+    int coins() const { return currentCoins; }
+
+    // 立即发布尚未发布的变化
+    void flush();
+
+public slots:
+    void setHealth(float health, float maxHealth);
+    void setScore(int score);
+    void setCoins(int coins);
+
+signals:
+    void changed(HudState::Fields fields);
+
+private:
+    void markDirty(Fields fields);
+
+    float currentHealth = 0.0f;
+    float currentMaxHealth = 0.0f;
+    int currentScore = 0;
+    int currentCoins = 0;
+
+    Fields dirtyFields;
+    QTimer flushTimer;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(HudState::Fields)
+
+#endif // HUDSTATE_H
@@ -0,0 +1,247 @@
+#include "MapGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+// SplitMix64：足够快且跨平台结果一致（std::分布的实现因标准库而异）
+class MapGenerator::Random
+{
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // [lo, hi] 闭区间
+    int range(int lo, int hi)
+    {
+        return lo + static_cast<int>(next() % static_cast<uint64_t>(hi - lo + 1));
+    }
+
+private:
+    uint64_t state;
+};
+
+namespace {
+// 为每个区域派生独立的随机流
+uint64_t deriveSeed(uint64_t seed, uint64_t stream)
+{
+    uint64_t z = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    z = (z ^ (z >> 33)) * 0xFF51AFD7ED558CCDull;
+    z = (z ^ (z >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return z ^ (z >> 33);
+}
+}
+
+MapGenerator::MapGenerator(const MapGenConfig &config)
+    : config(config)
+{
+}
+
+GeneratedMap MapGenerator::generate() const
+{
+    GeneratedMap map;
+    map.rows = std::max(1, config.rows);
+    map.cols = std::max(3, config.cols); // 至少：起点、一列路径、Boss
+    map.cells.assign(static_cast<size_t>(map.rows) * map.cols, NodeType::Empty);
+
+    map.startRow = map.rows / 2;
+    map.startCol = 0;
+    map.bossRow = map.rows / 2;
+    map.bossCol = map.cols - 1;
+    map.cells[map.index(map.startRow, map.startCol)] = NodeType::Start;
+    map.cells[map.index(map.bossRow, map.bossCol)] = NodeType::Boss;
+
+    // 把起点到Boss之间的列切成若干区域，区域之间只通过关口行相连
+    std::vector<Region> regions;
+    int regionWidth = std::max(1, config.regionWidth);
+    for (int col = 0; col < map.bossCol; col += regionWidth) {
+        regions.push_back({col, std::min(col + regionWidth, map.bossCol)});
+    }
+
+    int pathCount = std::max({1, config.minPaths, static_cast<int>(map.rows * config.pathDensity)});
+    int gateStride = static_cast<int>(regions.size()) + 1;
+    std::vector<int> gates(static_cast<size_t>(pathCount) * gateStride);
+    generateGates(gates, pathCount, regions, map);
+
+    // 各区域写入互不重叠的列，可以并行生成
+    int regionCount = static_cast<int>(regions.size());
+    int threadCount = config.threads > 0 ? config.threads
+                                         : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, regionCount));
+
+    std::atomic<int> nextRegion(0);
+    auto worker = [&]() {
+        for (int r = nextRegion++; r < regionCount; r = nextRegion++) {
+            generateRegion(map, r, regions[r], gates, pathCount, gateStride);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // 路径构造保证连通，这里再做一次校验
+    if (!isBossReachable(map)) {
+        carveFallbackPath(map);
+    }
+
+    return map;
+}
+
+void MapGenerator::generateGates(std::vector<int> &gates, int pathCount,
+                                 const std::vector<Region> &regions, const GeneratedMap &map) const
+{
+    Random random(deriveSeed(config.seed, 0));
+    int regionCount = static_cast<int>(regions.size());
+    int stride = regionCount + 1;
+
+    for (int p = 0; p < pathCount; p++) {
+        // 每条路径向自己的"车道"散开，形成扇形
+        int lane = static_cast<int>((p + 0.5f) * map.rows / pathCount);
+        int row = map.startRow;
+        gates[p * stride] = row;
+
+        for (int k = 1; k < regionCount; k++) {
+            int col = regions[k].firstCol;
+            int span = col - regions[k - 1].firstCol;
+            int remaining = map.bossCol - col;
+
+            // 一列最多移动一行，并且必须还能走到Boss
+            int lo = std::max({row - span, map.bossRow - remaining, 0});
+            int hi = std::min({row + span, map.bossRow + remaining, map.rows - 1});
+            int jitter = std::max(1, span / 4);
+            row = std::clamp(lane + random.range(-jitter, jitter), lo, hi);
+            gates[p * stride + k] = row;
+        }
+
+        gates[p * stride + regionCount] = map.bossRow;
+    }
+}
+
+void MapGenerator::generateRegion(GeneratedMap &map, int regionIndex, const Region &region,
+                                  const std::vector<int> &gates, int pathCount, int gateStride) const
+{
+    Random random(deriveSeed(config.seed, static_cast<uint64_t>(regionIndex) + 1));
+
+    for (int p = 0; p < pathCount; p++) {
+        int row = gates[p * gateStride + regionIndex];
+        int target = gates[p * gateStride + regionIndex + 1];
+        NodeType previous = NodeType::Empty;
+
+        for (int col = region.firstCol; col < region.endCol; col++) {
+            if (col > 0) { // 第0列是起点
+                NodeType &cell = map.cells[map.index(row, col)];
+                if (cell == NodeType::Empty) {
+                    cell = pickNodeType(random, col, map.cols, col == region.firstCol, previous);
+                }
+                previous = cell;
+            }
+
+            // 走向下一列：只保留仍能到达关口的方向
+            int remaining = region.endCol - (col + 1);
+            int candidates[3];
+            int count = 0;
+            for (int d = -1; d <= 1; d++) {
+                int next = row + d;
+                if (next >= 0 && next < map.rows && std::abs(target - next) <= remaining) {
+                    candidates[count++] = next;
+                }
+            }
+            row = candidates[random.range(0, count - 1)];
+        }
+    }
+}
+
+NodeType MapGenerator::pickNodeType(Random &random, int col, int cols, bool regionStart, NodeType previous) const
+{
+    // Boss前一列固定为酒馆（休息点）
+    if (col == cols - 2) return NodeType::Tavern;
+
+    // 宝藏按固定列间隔出现
+    int spacing = config.treasureSpacing;
+    if (spacing > 0 && col >= 2 && col % spacing == spacing / 2) return NodeType::Treasure;
+
+    bool late = col >= config.minEliteColumn;
+    int roll = random.range(0, 99);
+    NodeType type;
+    if (roll < 45) {
+        type = NodeType::Combat;
+    } else if (roll < 67) {
+        type = NodeType::Event;
+    } else if (roll < 79) {
+        type = late ? NodeType::Elite : NodeType::Combat;
+    } else if (roll < 87) {
+        type = NodeType::Shop;
+    } else {
+        type = late ? NodeType::Tavern : NodeType::Event;
+    }
+
+    // 商店/精英/酒馆不能连续出现；区域首列的前驱属于其他区域，直接不放
+    bool special = type == NodeType::Elite || type == NodeType::Shop || type == NodeType::Tavern;
+    if (special && (regionStart || type == previous)) {
+        type = NodeType::Combat;
+    }
+    // 避免与Boss前的酒馆相连
+    if (type == NodeType::Tavern && col == cols - 3) {
+        type = NodeType::Combat;
+    }
+    return type;
+}
+
+bool MapGenerator::isBossReachable(const GeneratedMap &map)
+{
+    if (map.cells.empty()) return false;
+
+    std::vector<uint8_t> seen(map.cells.size(), 0);
+    std::vector<int> queue;
+    queue.reserve(map.cells.size() / 4);
+
+    int start = map.index(map.startRow, map.startCol);
+    int boss = map.index(map.bossRow, map.bossCol);
+    queue.push_back(start);
+    seen[start] = 1;
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        if (current == boss) return true;
+
+        int row = current % map.rows;
+        int col = current / map.rows;
+        for (int d = -1; d <= 1; d++) {
+            if (!map.isNode(row + d, col + 1)) continue;
+            int next = map.index(row + d, col + 1);
+            if (!seen[next]) {
+                seen[next] = 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+void MapGenerator::carveFallbackPath(GeneratedMap &map) const
+{
+    // 直接从起点走向Boss，空位补成战斗节点
+    int row = map.startRow;
+    for (int col = map.startCol + 1; col < map.bossCol; col++) {
+        if (row < map.bossRow) row++;
+        else if (row > map.bossRow) row--;
+
+        NodeType &cell = map.cells[map.index(row, col)];
+        if (cell == NodeType::Empty) {
+            cell = NodeType::Combat;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef MAPGENERATOR_H
+#define MAPGENERATOR_H
+
+#include <cstdint>
+#include <vector>
+
+enum class NodeType : uint8_t {
+    Empty,
+    Start,
+    Combat,
+    Elite,
+    Shop,
+    Tavern,
+    Event,
+    Treasure,
+    Boss
+};
+
+// 地图生成参数
+struct MapGenConfig {
+    int rows = 7;
+    int cols = 7;
+    uint64_t seed = 0;
+
+    float pathDensity = 0.5f;   // 每行平均路径数
+    int minPaths = 2;
+    int regionWidth = 64;       // 每个并行区域的列数
+    int treasureSpacing = 8;    // 宝藏列间隔
+    int minEliteColumn = 4;     // 精英/酒馆最早出现的列
+    int threads = 0;            // 0 = 自动
+};
+
+// 生成结果：按列优先存储的紧凑节点类型数组（一个字节一个节点）
+struct GeneratedMap {
+    int rows = 0;
+    int cols = 0;
+    int startRow = 0;
+    int startCol = 0;
+    int bossRow = 0;
+    int bossCol = 0;
+    std::vector<NodeType> cells;
+
+    int index(int row, int col) const { return col * rows + row; }
+    NodeType at(int row, int col) const { return cells[index(row, col)]; }
+    bool isNode(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols && at(row, col) != NodeType::Empty;
+    }
+};
+
+// 分层路径地图生成器：相同种子得到相同地图，与线程数无关
+// 节点只连接到下一列中行号相差不超过1的节点
+class MapGenerator
+{
+public:
+    explicit MapGenerator(const MapGenConfig &config);
+
+    GeneratedMap generate() const;
+
+    // BFS检查起点是否能到达Boss
+    static bool isBossReachable(const GeneratedMap &map);
+
+private:
+    struct Region {
+        int firstCol;
+        int endCol;     // 下一个关口所在列（不包含）
+    };
+
+    class Random;
+
+    void generateGates(std::vector<int> &gates, int pathCount,
+                       const std::vector<Region> &regions, const GeneratedMap &map) const;
+    void generateRegion(GeneratedMap &map, int regionIndex, const Region &region,
+                        const std::vector<int> &gates, int pathCount, int gateStride) const;
+    NodeType pickNodeType(Random &random, int col, int cols, bool regionStart, NodeType previous) const;
+    void carveFallbackPath(GeneratedMap &map) const;
+
+    MapGenConfig config;
+};
+
+#endif // MAPGENERATOR_H
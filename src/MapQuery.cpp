@@ -0,0 +1,213 @@
+#include "MapQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+MapQuery::MapQuery()
+    : mapRows(0)
+    , mapCols(0)
+    , store(nullptr)
+    , originX(0.0)
+    , originY(0.0)
+    , hSpacing(1.0)
+    , vSpacing(1.0)
+    , hitSize(1.0)
+    , sourceRow(-1)
+    , sourceCol(-1)
+    , fieldDirty(true)
+{
+    // 默认代价：精英更危险，休整类节点更便宜
+    std::fill(std::begin(typeCosts), std::end(typeCosts), 1.0f);
+    setTypeCost(NodeType::Start, 0.0f);
+    setTypeCost(NodeType::Elite, 3.0f);
+    setTypeCost(NodeType::Shop, 0.5f);
+    setTypeCost(NodeType::Tavern, 0.5f);
+    setTypeCost(NodeType::Treasure, 0.5f);
+}
+
+void MapQuery::setMap(const MapStore &mapStore)
+{
+    store = &mapStore;
+    mapRows = mapStore.rows();
+    mapCols = mapStore.cols();
+    fieldDirty = true;
+}
+
+bool MapQuery::isNode(int row, int col) const
+{
+    return store && store->isNode(row, col);
+}
+
+void MapQuery::setTransform(double x, double y, double hSpace, double vSpace, double hit)
+{
+    originX = x;
+    originY = y;
+    hSpacing = hSpace > 0.0 ? hSpace : 1.0;
+    vSpacing = vSpace > 0.0 ? vSpace : 1.0;
+    hitSize = hit;
+}
+
+bool MapQuery::hitTest(double x, double y, int &row, int &col) const
+{
+    // 反算最近的网格坐标，只检查这一个格子
+    int c = static_cast<int>(std::lround((x - originX) / hSpacing)) - 1;
+    int r = static_cast<int>(std::lround((y - originY) / vSpacing)) - 1;
+    if (!isNode(r, c)) return false;
+
+    double centerX = originX + (c + 1) * hSpacing;
+    double centerY = originY + (r + 1) * vSpacing;
+    if (std::fabs(x - centerX) > hitSize / 2 || std::fabs(y - centerY) > hitSize / 2) {
+        return false;
+    }
+
+    row = r;
+    col = c;
+    return true;
+}
+
+void MapQuery::setTypeCost(NodeType type, float cost)
+{
+    typeCosts[static_cast<int>(type)] = std::max(0.0f, cost);
+    fieldDirty = true;
+}
+
+float MapQuery::minTypeCost() const
+{
+    float result = kUnreachable;
+    for (int t = static_cast<int>(NodeType::Combat); t <= static_cast<int>(NodeType::Boss); t++) {
+        result = std::min(result, typeCosts[t]);
+    }
+    return result == kUnreachable ? 0.0f : result;
+}
+
+void MapQuery::setSource(int row, int col)
+{
+    if (row == sourceRow && col == sourceCol) return;
+    sourceRow = row;
+    sourceCol = col;
+    fieldDirty = true;
+}
+
+void MapQuery::rebuildDistanceField() const
+{
+    distances.assign(static_cast<size_t>(mapRows) * mapCols, kUnreachable);
+    fieldDirty = false;
+    if (!isNode(sourceRow, sourceCol)) return;
+
+    // 图按列构成DAG，逐列松弛即可得到最短距离（无需优先队列）
+    // 每前进一列可达行最多扩展一行，只遍历这个范围
+    distances[index(sourceRow, sourceCol)] = 0.0f;
+    int lo = sourceRow;
+    int hi = sourceRow;
+    for (int col = sourceCol; col < mapCols - 1; col++) {
+        int nextLo = mapRows;
+        int nextHi = -1;
+        for (int row = lo; row <= hi; row++) {
+            float distance = distances[index(row, col)];
+            if (distance == kUnreachable) continue;
+
+            for (int next = row - 1; next <= row + 1; next++) {
+                if (!isNode(next, col + 1)) continue;
+                float &slot = distances[index(next, col + 1)];
+                slot = std::min(slot, distance + typeCost(store->type(next, col + 1)));
+                nextLo = std::min(nextLo, next);
+                nextHi = std::max(nextHi, next);
+            }
+        }
+        if (nextHi < 0) break;
+        lo = nextLo;
+        hi = nextHi;
+    }
+}
+
+float MapQuery::distanceTo(int row, int col) const
+{
+    if (row < 0 || row >= mapRows || col < 0 || col >= mapCols) return kUnreachable;
+    if (fieldDirty) rebuildDistanceField();
+    return distances[index(row, col)];
+}
+
+std::vector<MapCell> MapQuery::routeTo(int row, int col) const
+{
+    std::vector<MapCell> route;
+    if (!isReachable(row, col)) return route;
+
+    // 沿距离场回溯：前驱取距离最小者
+    route.push_back({row, col});
+    while (row != sourceRow || col != sourceCol) {
+        int bestRow = -1;
+        float best = kUnreachable;
+        for (int prev = row - 1; prev <= row + 1; prev++) {
+            float distance = distanceTo(prev, col - 1);
+            if (distance < best) {
+                best = distance;
+                bestRow = prev;
+            }
+        }
+        if (bestRow < 0) break;
+        row = bestRow;
+        col--;
+        route.push_back({row, col});
+    }
+
+    std::reverse(route.begin(), route.end());
+    return route;
+}
+
+std::vector<MapCell> MapQuery::findPath(int fromRow, int fromCol, int toRow, int toCol) const
+{
+    std::vector<MapCell> path;
+    if (!isNode(fromRow, fromCol) || !isNode(toRow, toCol) || toCol < fromCol) return path;
+
+    // 启发式：剩余列数 * 最小代价（可采纳）
+    float minCost = minTypeCost();
+    auto heuristic = [&](int col) { return (toCol - col) * minCost; };
+
+    using QueueItem = std::pair<float, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+    std::unordered_map<int, float> gScore;
+    std::unordered_map<int, int> cameFrom;
+
+    int start = index(fromRow, fromCol);
+    int goal = index(toRow, toCol);
+    gScore[start] = 0.0f;
+    open.push({heuristic(fromCol), start});
+
+    while (!open.empty()) {
+        auto [f, current] = open.top();
+        open.pop();
+
+        int row = current % mapRows;
+        int col = current / mapRows;
+        float g = gScore[current];
+        if (f > g + heuristic(col)) continue; // 过期条目
+
+        if (current == goal) {
+            for (int node = goal; ; node = cameFrom[node]) {
+                path.push_back({node % mapRows, node / mapRows});
+                if (node == start) break;
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        if (col >= toCol) continue;
+        for (int next = row - 1; next <= row + 1; next++) {
+            // 剩余列数不足以到达目标行的分支直接剪掉
+            if (!isNode(next, col + 1) || std::abs(toRow - next) > toCol - (col + 1)) continue;
+
+            int neighbor = index(next, col + 1);
+            float tentative = g + typeCost(store->type(next, col + 1));
+            auto it = gScore.find(neighbor);
+            if (it == gScore.end() || tentative < it->second) {
+                gScore[neighbor] = tentative;
+                cameFrom[neighbor] = current;
+                open.push({tentative + heuristic(col + 1), neighbor});
+            }
+        }
+    }
+
+    return path;
+}
@@ -0,0 +1,68 @@
+#ifndef MAPQUERY_H
+#define MAPQUERY_H
+
+#include "MapStore.h"
+#include <limits>
+#include <vector>
+
+struct MapCell {
+    int row;
+    int col;
+};
+
+// 地图查询服务：常数时间命中测试、最短路径和缓存的距离场
+// 图结构与MapGenerator一致：节点只连到下一列行号相差不超过1的节点
+class MapQuery
+{
+public:
+    static constexpr float kUnreachable = std::numeric_limits<float>::infinity();
+
+    MapQuery();
+
+    // 只保存指针，store需在MapQuery使用期间保持有效
+    void setMap(const MapStore &store);
+    int rows() const { return mapRows; }
+    int cols() const { return mapCols; }
+    bool isNode(int row, int col) const;
+
+    // 网格到屏幕的变换：center = origin + (index + 1) * spacing
+    void setTransform(double originX, double originY, double hSpacing, double vSpacing, double hitSize);
+    bool hitTest(double x, double y, int &row, int &col) const;
+
+    // 进入该类型节点的代价
+    void setTypeCost(NodeType type, float cost);
+    float typeCost(NodeType type) const { return typeCosts[static_cast<int>(type)]; }
+
+    // 距离场：以source为起点，结果缓存到source或地图/代价改变
+    void setSource(int row, int col);
+    float distanceTo(int row, int col) const;
+    bool isReachable(int row, int col) const { return distanceTo(row, col) != kUnreachable; }
+    std::vector<MapCell> routeTo(int row, int col) const;
+
+    // 任意两点之间的A*寻路（不使用缓存）
+    std::vector<MapCell> findPath(int fromRow, int fromCol, int toRow, int toCol) const;
+
+private:
+    int index(int row, int col) const { return col * mapRows + row; }
+    void rebuildDistanceField() const;
+    float minTypeCost() const;
+
+    int mapRows;
+    int mapCols;
+    const MapStore *store;
+
+    double originX;
+    double originY;
+    double hSpacing;
+    double vSpacing;
+    double hitSize;
+
+    float typeCosts[static_cast<int>(NodeType::Boss) + 1];
+
+    int sourceRow;
+    int sourceCol;
+    mutable std::vector<float> distances;
+    mutable bool fieldDirty;
+};
+
+#endif // MAPQUERY_H
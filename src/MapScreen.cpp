@@ -1,10 +1,13 @@
 #include "MapScreen.h"
+#include "MapView.h"
 #include <QPainter>
 #include <QLinearGradient>
 #include <QFont>
 #include <QDebug>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QPaintEvent>
+#include <QResizeEvent>
 #include <algorithm>
 #include <math.h>
 #include <random>
@@ -13,58 +16,133 @@ using std::max;
 using std::min;
 using std::abs;
 
+namespace {
+// 超过这个格子数时QPainter逐节点绘制开销过大，切换到GPU视图
+const int kGpuViewCellThreshold = 64 * 64;
+}
+
 MapScreen::MapScreen(QWidget *parent)
     : QWidget(parent)
+    , mapWidget(nullptr)
+    , mapView(nullptr)
+    , gpuViewActive(false)
     , currentNodeRow(-1)
     , currentNodeCol(-1)
     , mapRows(7)
     , mapCols(7)
+    , mapSeed(std::random_device{}())
+    , hoverNodeRow(-1)
+    , hoverNodeCol(-1)
+    , mapLayerDirty(true)
+    , symbolFont("Arial", 12, QFont::Bold)
 {
     // 设置背景色
     QPalette pal = palette();
     pal.setColor(QPalette::Window, QColor(40, 40, 60));
-    setAutoFillBackground(true);
     setPalette(pal);
     
-    initializeMap();
+    // 背景由缓存层完整覆盖，不需要Qt预先填充
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMouseTracking(true);
+    
     setupUI();
+    initializeMap();
+    updateLayout();
 }
 
 void MapScreen::initializeMap()
 {
-    // 初始化地图节点
-    mapNodes.clear();
-    mapNodes.resize(mapRows);
-    
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> typeDist(0, 4); // 0-4种类型
-    std::uniform_int_distribution<> rowDist(0, mapRows - 1);
-    
-    // 生成起始节点（第一列中间位置）
-    int startRow = mapRows / 2;
-    int startCol = mapCols / 2;
-    Node startNode;
-    startNode.type = NodeType::Start;
-    startNode.row = startRow;
-    startNode.col = startCol;
-    startNode.visited = true;
-    startNode.unlocked = true;
-    mapNodes[startRow].resize(mapCols);
-    mapNodes[startRow][startCol] = startNode;
-    
-    {//临时boss节点供调试、
-        Node endNode;
-        endNode.type = NodeType::Boss;
-        endNode.row = startRow;
-        endNode.col = startCol + 1;
-        endNode.visited = false;
-        endNode.unlocked = true;
-        mapNodes[startRow][startCol + 1] = endNode;
+    // 生成分层路径地图，直接写入紧凑存储
+    MapGenConfig config;
+    config.rows = mapRows;
+    config.cols = mapCols;
+    config.seed = mapSeed;
+    mapStore.assign(MapGenerator(config).generate(), mapSeed);
+    gpuViewActive = false; // 视图在applyMapStore中按新地图整体重建
+    
+    // 起始节点（第一列中间位置）
+    mapStore.setVisited(mapStore.startRow(), mapStore.startCol(), true);
+    mapStore.setUnlocked(mapStore.startRow(), mapStore.startCol(), true);
+    mapStore.setCurrent(mapStore.startRow(), mapStore.startCol());
+    unlockAdjacentNodes(mapStore.startRow(), mapStore.startCol());
+    
+    applyMapStore();
+}
+
+void MapScreen::applyMapStore()
+{
+    mapRows = mapStore.rows();
+    mapCols = mapStore.cols();
+    mapSeed = mapStore.seed();
+    mapQuery.setMap(mapStore);
+    
+    currentNodeRow = mapStore.currentRow();
+    currentNodeCol = mapStore.currentCol();
+    hoverNodeRow = -1;
+    hoverNodeCol = -1;
+    hoverRoute.clear();
+    mapQuery.setSource(currentNodeRow, currentNodeCol);
+    
+    gpuViewActive = mapRows * mapCols > kGpuViewCellThreshold;
+    if (gpuViewActive) {
+        ensureMapView();
+        mapView->setMap(mapStore);
+        mapView->setCurrentNode(currentNodeRow, currentNodeCol);
+    }
+    if (mapView) {
+        mapView->setVisible(gpuViewActive);
+    }
+    
+    invalidateMapLayer();
+}
+
+bool MapScreen::saveMap(const QString &path)
+{
+    // 同一文件只写入变化的数据块
+    return mapStore.save(path);
+}
+
+bool MapScreen::loadMap(const QString &path)
+{
+    // 载入时已校验节点类型和当前位置；失败时mapStore和界面状态都保持原样
+    if (!mapStore.load(path, MapStore::LoadMode::Copy)) {
+        return false;
     }
+    applyMapStore();
+    
+    updateLayout();
+    updateStatusLabel();
+    return true;
+}
+
+void MapScreen::ensureMapView()
+{
+    if (mapView) return;
+    
+    // 填满地图容器，节点点击沿用同一套规则
+    mapView = new MapView(mapWidget);
+    QVBoxLayout *mapViewLayout = new QVBoxLayout(mapWidget);
+    mapViewLayout->setContentsMargins(0, 0, 0, 0);
+    mapViewLayout->addWidget(mapView);
+    connect(mapView, &MapView::nodeClicked, this, &MapScreen::handleNodeClick);
+}
+
+void MapScreen::syncMapView(int row, int col)
+{
+    if (!gpuViewActive) return;
+    
+    mapView->setNodeState(row, col, mapStore.isVisited(row, col), mapStore.isUnlocked(row, col));
+}
 
-    currentNodeRow = startRow;
-    currentNodeCol = startCol;
+void MapScreen::generateMap(int rows, int cols, quint64 seed)
+{
+    mapRows = rows;
+    mapCols = cols;
+    mapSeed = seed;
+    
+    initializeMap();
+    updateLayout();
+    updateStatusLabel();
 }
 
 void MapScreen::setupUI()
@@ -114,60 +192,113 @@ void MapScreen::setupUI()
     connect(backButton, &QPushButton::clicked, this, &MapScreen::backToMenu);
 }
 
+void MapScreen::updateLayout()
+{
+    // 设置地图绘制区域
+    layout.startX = (width() - layout.mapWidth) / 2;
+    layout.hSpacing = layout.mapWidth / (mapCols + 1);
+    layout.vSpacing = layout.mapHeight / (mapRows + 1);
+    
+    mapQuery.setTransform(layout.startX, layout.startY, layout.hSpacing, layout.vSpacing, layout.hitSize);
+}
+
+void MapScreen::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    
+    updateLayout();
+    backgroundLayer = QPixmap();
+    invalidateMapLayer();
+}
+
+void MapScreen::invalidateMapLayer()
+{
+    mapLayerDirty = true;
+    update();
+}
+
+QPixmap MapScreen::createLayerPixmap() const
+{
+    // 按设备像素比创建，避免高DPI屏幕上模糊
+    qreal dpr = devicePixelRatioF();
+    QPixmap pixmap(size() * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    return pixmap;
+}
+
+void MapScreen::ensureLayers()
+{
+    // 移动到不同DPI的屏幕后需要重建
+    qreal dpr = devicePixelRatioF();
+    if (!backgroundLayer.isNull() && backgroundLayer.devicePixelRatio() != dpr) {
+        backgroundLayer = QPixmap();
+        mapLayerDirty = true;
+    }
+    
+    if (backgroundLayer.isNull()) {
+        backgroundLayer = createLayerPixmap();
+        QPainter painter(&backgroundLayer);
+        renderBackgroundLayer(painter);
+    }
+    
+    if (mapLayerDirty || mapLayer.isNull()) {
+        mapLayer = createLayerPixmap();
+        QPainter painter(&mapLayer);
+        painter.setRenderHint(QPainter::Antialiasing);
+        renderMapLayer(painter);
+        mapLayerDirty = false;
+    }
+}
+
 void MapScreen::paintEvent(QPaintEvent *event)
 {
-    QWidget::paintEvent(event);
+    ensureLayers();
     
+    // 只合成需要重绘的区域
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    const QRect dirty = event->rect();
+    auto blitLayer = [&](const QPixmap &layer) {
+        qreal dpr = layer.devicePixelRatio();
+        painter.drawPixmap(QRectF(dirty), layer,
+                           QRectF(QPointF(dirty.topLeft()) * dpr, QSizeF(dirty.size()) * dpr));
+    };
+    blitLayer(backgroundLayer);
+    blitLayer(mapLayer);
     
+    painter.setRenderHint(QPainter::Antialiasing);
+    drawDynamicLayer(painter, dirty);
+}
+
+void MapScreen::renderBackgroundLayer(QPainter &painter)
+{
     // 绘制渐变背景
     QLinearGradient gradient(0, 0, width(), height());
     gradient.setColorAt(0, QColor(30, 30, 50));
     gradient.setColorAt(1, QColor(50, 50, 80));
     painter.fillRect(rect(), gradient);
     
-    // 绘制地图区域
-    drawMap(painter);
+    // 绘制地图背景（GPU视图自己清屏）
+    if (gpuViewActive) return;
+    painter.fillRect(layout.startX, layout.startY, layout.mapWidth, layout.mapHeight,
+                     QColor(30, 30, 40, 200));
 }
 
-void MapScreen::drawMap(QPainter &painter)
+void MapScreen::renderMapLayer(QPainter &painter)
 {
-    // 设置地图绘制区域
-    int mapWidth = 600;
-    int mapHeight = 400;
-    int startX = (width() - mapWidth) / 2;
-    int startY = 120;
-    
-    // 绘制地图背景
-    painter.fillRect(startX, startY, mapWidth, mapHeight, QColor(30, 30, 40, 200));
-    
-    // 计算节点位置和大小
-    int nodeSize = 20;
-    int horizontalSpacing = mapWidth / (mapCols + 1);
-    int verticalSpacing = mapHeight / (mapRows + 1);
+    if (gpuViewActive) return;
     
     // 绘制连接线
     painter.setPen(QPen(QColor(100, 150, 200, 150), 3));
     
     for (int col = 0; col < mapCols - 1; col++) {
         for (int row = 0; row < mapRows; row++) {
-            if (!mapNodes[row].isEmpty() && mapNodes[row][col].type != NodeType::Empty) {
-                Node currentNode = mapNodes[row][col];
-                
+            if (isNode(row, col)) {
                 // 连接到右侧相邻节点
                 for (int nextRow = max(0, row-1); nextRow <= min(mapRows-1, row+1); nextRow++) {
-                    if (col + 1 < mapCols && !mapNodes[nextRow].isEmpty() && 
-                        mapNodes[nextRow][col+1].type != NodeType::Empty) {
-                        
-                        QPoint currentPos = getNodePosition(currentNode.row, currentNode.col,
-                                                           startX, startY, 
-                                                           horizontalSpacing, verticalSpacing);
-                        QPoint nextPos = getNodePosition(nextRow, col+1,
-                                                        startX, startY,
-                                                        horizontalSpacing, verticalSpacing);
-                        
-                        painter.drawLine(currentPos, nextPos);
+                    if (isNode(nextRow, col + 1)) {
+                        painter.drawLine(getNodePosition(row, col),
+                                         getNodePosition(nextRow, col+1));
                     }
                 }
             }
@@ -175,42 +306,97 @@ void MapScreen::drawMap(QPainter &painter)
     }
     
     // 绘制所有节点
+    painter.setFont(symbolFont);
     for (int row = 0; row < mapRows; row++) {
         for (int col = 0; col < mapCols; col++) {
-            if (!mapNodes[row].isEmpty() && mapNodes[row][col].type != NodeType::Empty) {
-                drawNode(painter, mapNodes[row][col], startX, startY, 
-                        horizontalSpacing, verticalSpacing, nodeSize);
+            if (isNode(row, col)) {
+                drawNode(painter, row, col, mapQuery.isReachable(row, col));
             }
         }
     }
 }
 
-QPoint MapScreen::getNodePosition(int row, int col, int startX, int startY, 
-                                 int hSpacing, int vSpacing)
+void MapScreen::drawDynamicLayer(QPainter &painter, const QRect &clip)
 {
-    static std::map<std::pair<int, int>, QPoint> positionCache;
-    auto key = std::make_pair(row, col);
+    if (gpuViewActive) return;
+    
+    painter.setBrush(Qt::NoBrush);
+    
+    // 到悬停节点的最短路线
+    if (!hoverRoute.empty() && routeRect().intersects(clip)) {
+        drawRoute(painter);
+    }
     
-    if (positionCache.find(key) == positionCache.end()) {
-        int baseX = startX + (col + 1) * hSpacing;
-        int baseY = startY + (row + 1) * vSpacing;
-        positionCache[key] = QPoint(baseX, baseY);
+    // 悬停高亮
+    if (hoverNodeRow >= 0 && dynamicRect(hoverNodeRow, hoverNodeCol).intersects(clip)) {
+        QPoint center = getNodePosition(hoverNodeRow, hoverNodeCol);
+        int radius = layout.nodeSize / 2 + 3;
+        painter.setPen(QPen(QColor(255, 255, 255, 160), 2));
+        painter.drawEllipse(center, radius, radius);
+    }
+    
+    // 绘制当前节点高亮
+    if (currentNodeRow >= 0 && dynamicRect(currentNodeRow, currentNodeCol).intersects(clip)) {
+        QPoint center = getNodePosition(currentNodeRow, currentNodeCol);
+        int radius = layout.nodeSize / 2 + 5;
+        painter.setPen(QPen(QColor(255, 255, 100), 2));
+        painter.drawEllipse(center, radius, radius);
+    }
+}
+
+QPoint MapScreen::getNodePosition(int row, int col) const
+{
+    return QPoint(layout.startX + (col + 1) * layout.hSpacing,
+                  layout.startY + (row + 1) * layout.vSpacing);
+}
+
+QRect MapScreen::dynamicRect(int row, int col) const
+{
+    // 高亮圈加上画笔宽度的范围
+    int extent = layout.nodeSize / 2 + 8;
+    QPoint center = getNodePosition(row, col);
+    return QRect(center.x() - extent, center.y() - extent, extent * 2, extent * 2);
+}
+
+void MapScreen::drawRoute(QPainter &painter)
+{
+    QPolygon polyline;
+    polyline.reserve(static_cast<int>(hoverRoute.size()));
+    for (const MapCell &cell : hoverRoute) {
+        polyline << getNodePosition(cell.row, cell.col);
     }
     
-    return positionCache[key];
+    painter.setPen(QPen(QColor(255, 220, 120, 200), 4, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+    painter.drawPolyline(polyline);
+}
+
+QRect MapScreen::routeRect() const
+{
+    if (hoverRoute.empty()) return QRect();
+    
+    // 路线按列单调前进，包围盒由首尾列和行的范围确定
+    int minRow = hoverRoute.front().row;
+    int maxRow = minRow;
+    for (const MapCell &cell : hoverRoute) {
+        minRow = min(minRow, cell.row);
+        maxRow = max(maxRow, cell.row);
+    }
+    QPoint topLeft = getNodePosition(minRow, hoverRoute.front().col);
+    QPoint bottomRight = getNodePosition(maxRow, hoverRoute.back().col);
+    return QRect(topLeft, bottomRight).normalized().adjusted(-4, -4, 4, 4);
 }
 
-void MapScreen::drawNode(QPainter &painter, const Node &node, int startX, int startY,
-                        int hSpacing, int vSpacing, int nodeSize)
+void MapScreen::drawNode(QPainter &painter, int row, int col, bool reachable)
 {
-    QPoint center = getNodePosition(node.row, node.col, startX, startY, hSpacing, vSpacing);
+    QPoint center = getNodePosition(row, col);
+    int nodeSize = layout.nodeSize;
     QRect nodeRect(center.x() - nodeSize/2, center.y() - nodeSize/2, nodeSize, nodeSize);
     
     // 设置节点颜色和样式
     QColor nodeColor;
     QString nodeSymbol;
     
-    switch (node.type) {
+    switch (mapStore.type(row, col)) {
         case NodeType::Start:
             nodeColor = QColor(100, 200, 100); // 绿色
             nodeSymbol = "S";
@@ -219,6 +405,10 @@ void MapScreen::drawNode(QPainter &painter, const Node &node, int startX, int st
             nodeColor = QColor(200, 100, 100); // 红色
             nodeSymbol = "⚔";
             break;
+        case NodeType::Elite:
+            nodeColor = QColor(220, 60, 60); // 深红色
+            nodeSymbol = "☠";
+            break;
         case NodeType::Shop:
             nodeColor = QColor(100, 100, 200); // 蓝色
             nodeSymbol = "$";
@@ -240,18 +430,23 @@ void MapScreen::drawNode(QPainter &painter, const Node &node, int startX, int st
             nodeSymbol = "👑";
             break;
         case NodeType::Empty:
+        default:
             return; // 不绘制空节点
     }
     
     // 绘制节点背景
-    if (node.visited) {
+    if (mapStore.isVisited(row, col)) {
         // 已访问的节点
         painter.setBrush(QBrush(nodeColor.lighter(130)));
         painter.setPen(QPen(nodeColor.darker(150), 3));
-    } else if (node.unlocked) {
+    } else if (mapStore.isUnlocked(row, col)) {
         // 已解锁但未访问
         painter.setBrush(QBrush(nodeColor));
         painter.setPen(QPen(nodeColor.darker(), 3));
+    } else if (reachable) {
+        // 未解锁但从当前位置可达
+        painter.setBrush(QBrush(QColor(95, 95, 125)));
+        painter.setPen(QPen(nodeColor.darker(130), 2));
     } else {
         // 未解锁
         painter.setBrush(QBrush(QColor(80, 80, 100)));
@@ -261,58 +456,85 @@ void MapScreen::drawNode(QPainter &painter, const Node &node, int startX, int st
     // 绘制节点圆
     painter.drawEllipse(nodeRect);
     
-    // 绘制当前节点高亮
-    if (node.row == currentNodeRow && node.col == currentNodeCol) {
-        painter.setPen(QPen(QColor(255, 255, 100), 2));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawEllipse(nodeRect.adjusted(-5, -5, 5, 5));
-    }
-    
-    // 绘制节点符号
+    // 绘制节点符号（字体在图层开始时设置一次）
     painter.setPen(QPen(Qt::white, 2));
-    QFont symbolFont("Arial", 12, QFont::Bold);
-    painter.setFont(symbolFont);
     painter.drawText(nodeRect, Qt::AlignCenter, nodeSymbol);
 }
 
+bool MapScreen::hitTestNode(const QPoint &pos, int &row, int &col) const
+{
+    // GPU视图自己处理点击
+    if (gpuViewActive) return false;
+    
+    // 反算网格坐标，常数时间
+    return mapQuery.hitTest(pos.x(), pos.y(), row, col);
+}
+
 void MapScreen::mousePressEvent(QMouseEvent *event)
 {
     QWidget::mousePressEvent(event);
     
-    // 检查是否点击了节点
-    int startX = (width() - 600) / 2;
-    int startY = 120;
-    int nodeSize = 40;
-    int horizontalSpacing = 600 / (mapCols + 1);
-    int verticalSpacing = 400 / (mapRows + 1);
+    int row, col;
+    if (hitTestNode(event->pos(), row, col)) {
+        handleNodeClick(row, col);
+    }
+}
+
+void MapScreen::mouseMoveEvent(QMouseEvent *event)
+{
+    QWidget::mouseMoveEvent(event);
     
-    for (int row = 0; row < mapRows; row++) {
-        for (int col = 0; col < mapCols; col++) {
-            if (!mapNodes[row].isEmpty() && mapNodes[row][col].type != NodeType::Empty) {
-                QPoint nodeCenter = getNodePosition(row, col, startX, startY, 
-                                                   horizontalSpacing, verticalSpacing);
-                QRect nodeRect(nodeCenter.x() - nodeSize/2, nodeCenter.y() - nodeSize/2,
-                              nodeSize, nodeSize);
-                
-                if (nodeRect.contains(event->pos())) {
-                    handleNodeClick(row, col);
-                    return;
-                }
-            }
-        }
+    int row = -1, col = -1;
+    if (!hitTestNode(event->pos(), row, col)) {
+        row = col = -1;
+    }
+    setHoverNode(row, col);
+}
+
+void MapScreen::leaveEvent(QEvent *event)
+{
+    QWidget::leaveEvent(event);
+    setHoverNode(-1, -1);
+}
+
+void MapScreen::setHoverNode(int row, int col)
+{
+    if (row == hoverNodeRow && col == hoverNodeCol) return;
+    
+    // 只重绘新旧高亮及路线所在的区域
+    if (hoverNodeRow >= 0) update(dynamicRect(hoverNodeRow, hoverNodeCol));
+    if (!hoverRoute.empty()) update(routeRect());
+    
+    hoverNodeRow = row;
+    hoverNodeCol = col;
+    hoverRoute.clear();
+    if (hoverNodeRow >= 0) {
+        hoverRoute = mapQuery.routeTo(row, col);
+        update(dynamicRect(hoverNodeRow, hoverNodeCol));
+        if (!hoverRoute.empty()) update(routeRect());
     }
 }
 
 void MapScreen::handleNodeClick(int row, int col)
 {
-    if (mapNodes[row][col].unlocked && !mapNodes[row][col].visited) {
-        // 检查是否是相邻节点
-        if (abs(row - currentNodeRow) + abs(col - currentNodeCol) == 1) {
+    if (mapStore.isUnlocked(row, col) && !mapStore.isVisited(row, col)) {
+        // 只能沿连接线前进到下一列
+        if (col == currentNodeCol + 1 && abs(row - currentNodeRow) <= 1) {
             // 移动到新节点
-            mapNodes[currentNodeRow][currentNodeCol].visited = true;
+            mapStore.setVisited(currentNodeRow, currentNodeCol, true);
+            syncMapView(currentNodeRow, currentNodeCol);
             currentNodeRow = row;
             currentNodeCol = col;
-            mapNodes[row][col].visited = true;
+            mapStore.setVisited(row, col, true);
+            mapStore.setCurrent(row, col);
+            syncMapView(row, col);
+            if (gpuViewActive) {
+                mapView->setCurrentNode(row, col);
+            }
+            
+            // 距离场以新位置为起点重建
+            mapQuery.setSource(row, col);
+            hoverRoute = mapQuery.routeTo(hoverNodeRow, hoverNodeCol);
             
             // 解锁相邻节点
             unlockAdjacentNodes(row, col);
@@ -320,30 +542,22 @@ void MapScreen::handleNodeClick(int row, int col)
             // 更新状态显示
             updateStatusLabel();
             
-            // 触发节点事件
-            triggerNodeEvent(mapNodes[row][col]);
+            // 节点状态变化，重建地图层
+            invalidateMapLayer();
             
-            // 重绘地图
-            update();
+            // 触发节点事件
+            triggerNodeEvent(row, col);
         }
     }
 }
 
 void MapScreen::unlockAdjacentNodes(int row, int col)
 {
-    // 解锁上下左右四个方向的节点
-    int directions[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-    
-    for (auto &dir : directions) {
-        int newRow = row + dir[0];
-        int newCol = col + dir[1];
-        
-        if (newRow >= 0 && newRow < mapRows && 
-            newCol >= 0 && newCol < mapCols &&
-            !mapNodes[newRow].isEmpty() && 
-            mapNodes[newRow][newCol].type != NodeType::Empty) {
-            
-            mapNodes[newRow][newCol].unlocked = true;
+    // 解锁下一列中相连的节点
+    for (int newRow = row - 1; newRow <= row + 1; newRow++) {
+        if (isNode(newRow, col + 1)) {
+            mapStore.setUnlocked(newRow, col + 1, true);
+            syncMapView(newRow, col + 1);
         }
     }
 }
@@ -352,24 +566,27 @@ void MapScreen::updateStatusLabel()
 {
     QString statusText = "当前位置: ";
     
-    switch (mapNodes[currentNodeRow][currentNodeCol].type) {
+    switch (mapStore.type(currentNodeRow, currentNodeCol)) {
         case NodeType::Start: statusText += "起始点"; break;
         case NodeType::Combat: statusText += "战斗关卡"; break;
+        case NodeType::Elite: statusText += "精英战斗"; break;
         case NodeType::Shop: statusText += "商店"; break;
         case NodeType::Tavern: statusText += "酒馆"; break;
         case NodeType::Event: statusText += "随机事件"; break;
         case NodeType::Treasure: statusText += "宝藏房间"; break;
         case NodeType::Boss: statusText += "Boss战"; break;
+        case NodeType::Empty: break;
     }
     
     statusLabel->setText(statusText);
 }
 
-void MapScreen::triggerNodeEvent(const Node &node)
+void MapScreen::triggerNodeEvent(int row, int col)
 {
-    switch (node.type) {
+    switch (mapStore.type(row, col)) {
         case NodeType::Combat:
-            emit combatLevelSelected(node.row * mapCols + node.col + 1);
+        case NodeType::Elite:
+            emit combatLevelSelected(row * mapCols + col + 1);
             break;
         case NodeType::Shop:
             emit shopEntered();
@@ -393,7 +610,6 @@ void MapScreen::triggerNodeEvent(const Node &node)
 
 void MapScreen::resetMap()
 {
-    initializeMap();
-    updateStatusLabel();
-    update();
+    // 换一个种子生成新地图
+    generateMap(mapRows, mapCols, std::random_device{}());
 }
\ No newline at end of file
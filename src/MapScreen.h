@@ -10,25 +10,13 @@
 #include <QGridLayout>
 #include <QVector>
 #include <QMouseEvent>
+#include <QPixmap>
+#include <QFont>
+#include "MapGenerator.h"
+#include "MapStore.h"
+#include "MapQuery.h"
 
-enum class NodeType {
-    Empty,
-    Start,
-    Combat,
-    Shop,
-    Tavern,
-    Event,
-    Treasure,
-    Boss
-};
-
-struct Node {
-    NodeType type = NodeType::Empty;
-    int row = -1;
-    int col = -1;
-    bool visited = false;
-    bool unlocked = false;
-};
+class MapView;
 
 class MapScreen : public QWidget
 {
@@ -37,6 +25,14 @@ class MapScreen : public QWidget
 public:
     explicit MapScreen(QWidget *parent = nullptr);
     
+    // 按种子重新生成地图（相同种子得到相同地图）
+    void generateMap(int rows, int cols, quint64 seed);
+    quint64 getMapSeed() const { return mapSeed; }
+    
+    // 存档：地图和进度保存在一个分块文件里，重复保存只写变化的块
+    bool saveMap(const QString &path);
+    bool loadMap(const QString &path);
+    
 signals:
     void backToMenu();
     void levelSelected(int level);
@@ -49,31 +45,83 @@ signals:
     
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
     
 private:
+    // 地图布局（尺寸变化时重新计算）
+    struct MapLayout {
+        int startX = 0;
+        int startY = 120;
+        int mapWidth = 600;
+        int mapHeight = 400;
+        int hSpacing = 0;
+        int vSpacing = 0;
+        int nodeSize = 20;
+        int hitSize = 40;
+    };
+    
     void setupUI();
     void initializeMap();
-    void drawMap(QPainter &painter);
-    void drawNode(QPainter &painter, const Node &node, int startX, int startY,
-                  int hSpacing, int vSpacing, int nodeSize);
-    QPoint getNodePosition(int row, int col, int startX, int startY,
-                          int hSpacing, int vSpacing);
+    void applyMapStore();
+    void updateLayout();
+    
+    // 大地图改用GPU视图（MapView），小地图保持QPainter分层绘制
+    void ensureMapView();
+    void syncMapView(int row, int col);
+    
+    // 分层缓存：背景层只随尺寸变化，地图层随地图状态变化，动态层每次重绘
+    void invalidateMapLayer();
+    void ensureLayers();
+    QPixmap createLayerPixmap() const;
+    void renderBackgroundLayer(QPainter &painter);
+    void renderMapLayer(QPainter &painter);
+    void drawDynamicLayer(QPainter &painter, const QRect &clip);
+    void drawNode(QPainter &painter, int row, int col, bool reachable);
+    void drawRoute(QPainter &painter);
+    QRect routeRect() const;
+    QPoint getNodePosition(int row, int col) const;
+    QRect dynamicRect(int row, int col) const;
+    bool hitTestNode(const QPoint &pos, int &row, int &col) const;
+    
+    bool isNode(int row, int col) const { return mapStore.isNode(row, col); }
+    void setHoverNode(int row, int col);
+    
     void handleNodeClick(int row, int col);
     void unlockAdjacentNodes(int row, int col);
     void updateStatusLabel();
-    void triggerNodeEvent(const Node &node);
+    void triggerNodeEvent(int row, int col);
     
     QLabel *titleLabel;
     QLabel *statusLabel;
     QPushButton *backButton;
     QWidget *mapWidget;
+    MapView *mapView;
+    bool gpuViewActive;
     
-    QVector<QVector<Node>> mapNodes;
+    // 每个格子一个字节：类型 + 已访问 + 已解锁
+    MapStore mapStore;
     int currentNodeRow;
     int currentNodeCol;
     int mapRows;
     int mapCols;
+    quint64 mapSeed;
+    
+    // 悬停节点及到它的最短路线
+    int hoverNodeRow;
+    int hoverNodeCol;
+    std::vector<MapCell> hoverRoute;
+    
+    // 命中测试、寻路和距离场
+    MapQuery mapQuery;
+    
+    MapLayout layout;
+    QPixmap backgroundLayer;
+    QPixmap mapLayer;
+    bool mapLayerDirty;
+    QFont symbolFont;
     
 public slots:
     void resetMap();
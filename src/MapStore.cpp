@@ -0,0 +1,307 @@
+#include "MapStore.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+const char kMagic[4] = {'M', 'A', 'P', 'S'};
+const uint32_t kVersion = 1;
+}
+
+MapStore::MapStore()
+    : chunkRows(0)
+    , chunkCount(0)
+    , cells(nullptr)
+    , mappedBase(nullptr)
+    , headerDirty(false)
+{
+    static_assert(std::is_trivially_copyable<Header>::value, "Header is written as raw bytes");
+    static_assert(sizeof(Header) <= kHeaderBytes, "Header must fit in the header block");
+    clear();
+}
+
+MapStore::~MapStore()
+{
+    unmap();
+}
+
+void MapStore::clear()
+{
+    unmap();
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.chunkSize = kChunkSize;
+    header.currentRow = -1;
+    header.currentCol = -1;
+    resetLayout(0, 0);
+    backingPath.clear();
+}
+
+void MapStore::resetLayout(int rows, int cols)
+{
+    header.rows = rows;
+    header.cols = cols;
+    chunkRows = static_cast<size_t>((rows + kChunkSize - 1) >> kChunkShift);
+    chunkCount = chunkRows * static_cast<size_t>((cols + kChunkSize - 1) >> kChunkShift);
+
+    storage.assign(dataBytes(), 0);
+    cells = storage.data();
+    dirtyChunks.assign(chunkCount, 1);
+    headerDirty = true;
+}
+
+void MapStore::unmap()
+{
+    if (!mappedFile) return;
+
+    // 映射区的修改由系统写回文件
+    mappedFile->unmap(mappedBase);
+    mappedFile->close();
+    mappedFile.reset();
+    mappedBase = nullptr;
+    cells = storage.data();
+}
+
+void MapStore::assign(const GeneratedMap &map, uint64_t seed)
+{
+    clear();
+    header.seed = seed;
+    header.startRow = map.startRow;
+    header.startCol = map.startCol;
+    header.bossRow = map.bossRow;
+    header.bossCol = map.bossCol;
+    resetLayout(map.rows, map.cols);
+
+    // 按列拷贝，块内也是列优先，每次写连续的一段
+    for (int col = 0; col < map.cols; col++) {
+        for (int row = 0; row < map.rows; row += kChunkSize) {
+            int count = std::min(kChunkSize, map.rows - row);
+            std::memcpy(cells + offset(row, col), &map.cells[map.index(row, col)], count);
+        }
+    }
+}
+
+void MapStore::setBit(int row, int col, uint8_t bit, bool value)
+{
+    uint8_t &cell = cells[offset(row, col)];
+    uint8_t updated = value ? (cell | bit) : (cell & ~bit);
+    if (updated == cell) return;
+
+    cell = updated;
+    dirtyChunks[chunkIndex(row, col)] = 1;
+}
+
+void MapStore::setCurrent(int row, int col)
+{
+    if (row == header.currentRow && col == header.currentCol) return;
+
+    header.currentRow = row;
+    header.currentCol = col;
+    headerDirty = true;
+}
+
+int MapStore::dirtyChunkCount() const
+{
+    return static_cast<int>(std::count(dirtyChunks.begin(), dirtyChunks.end(), 1));
+}
+
+size_t MapStore::memoryBytes() const
+{
+    // 映射模式下数据页由文件缓存承担
+    return (isMapped() ? 0 : storage.size()) + dirtyChunks.size() + sizeof(*this);
+}
+
+bool MapStore::save(const QString &path)
+{
+    if (!backingPath.isEmpty() && path == backingPath && QFile::exists(path)) {
+        return writeIncremental();
+    }
+    return writeFull(path);
+}
+
+bool MapStore::writeFull(const QString &path)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Cannot open map file for writing:" << path;
+        return false;
+    }
+
+    QByteArray headerBlock(kHeaderBytes, '\0');
+    std::memcpy(headerBlock.data(), &header, sizeof(header));
+    file.write(headerBlock);
+    file.write(reinterpret_cast<const char*>(cells), static_cast<qint64>(dataBytes()));
+    if (!file.commit()) {
+        qDebug() << "Failed to write map file:" << path;
+        return false;
+    }
+
+    // QSaveFile替换了文件，旧映射不再对应path，改为内存副本
+    if (isMapped()) {
+        storage.assign(cells, cells + dataBytes());
+        unmap();
+    }
+
+    backingPath = path;
+    std::fill(dirtyChunks.begin(), dirtyChunks.end(), 0);
+    headerDirty = false;
+    return true;
+}
+
+bool MapStore::writeIncremental()
+{
+    if (isMapped()) {
+        // 数据已经在文件映射里，只需更新文件头
+        std::memcpy(mappedBase, &header, sizeof(header));
+        std::fill(dirtyChunks.begin(), dirtyChunks.end(), 0);
+        headerDirty = false;
+        return true;
+    }
+
+    QFile file(backingPath);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qDebug() << "Cannot open map file for update:" << backingPath;
+        return false;
+    }
+    if (file.size() != kHeaderBytes + static_cast<qint64>(dataBytes())) {
+        file.close();
+        return writeFull(backingPath);
+    }
+
+    bool ok = true;
+    if (headerDirty) {
+        ok = file.seek(0) &&
+             file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+    }
+
+    // 相邻的脏块合并成一次写入
+    for (size_t chunk = 0; ok && chunk < chunkCount; ) {
+        if (!dirtyChunks[chunk]) {
+            chunk++;
+            continue;
+        }
+        size_t end = chunk;
+        while (end < chunkCount && dirtyChunks[end]) end++;
+
+        qint64 pos = kHeaderBytes + static_cast<qint64>(chunk) * kChunkBytes;
+        qint64 bytes = static_cast<qint64>(end - chunk) * kChunkBytes;
+        ok = file.seek(pos) &&
+             file.write(reinterpret_cast<const char*>(cells + chunk * kChunkBytes), bytes) == bytes;
+        chunk = end;
+    }
+
+    if (!ok) {
+        qDebug() << "Failed to update map file:" << backingPath;
+        return false;
+    }
+
+    std::fill(dirtyChunks.begin(), dirtyChunks.end(), 0);
+    headerDirty = false;
+    return true;
+}
+
+bool MapStore::validHeader(const Header &candidate, qint64 fileSize) const
+{
+    if (std::memcmp(candidate.magic, kMagic, sizeof(kMagic)) != 0 || candidate.version != kVersion) {
+        return false;
+    }
+    if (candidate.chunkSize != kChunkSize || candidate.rows <= 0 || candidate.cols <= 0) {
+        return false;
+    }
+    auto inside = [&candidate](int32_t row, int32_t col) {
+        return row >= 0 && row < candidate.rows && col >= 0 && col < candidate.cols;
+    };
+    if (!inside(candidate.startRow, candidate.startCol) || !inside(candidate.bossRow, candidate.bossCol)) {
+        return false;
+    }
+
+    qint64 chunks = static_cast<qint64>((candidate.rows + kChunkSize - 1) >> kChunkShift) *
+                    ((candidate.cols + kChunkSize - 1) >> kChunkShift);
+    return fileSize == kHeaderBytes + chunks * kChunkBytes;
+}
+
+bool MapStore::validCells() const
+{
+    // 映射模式不逐格扫描（会把整个文件读入），越界类型由cellType在读取时处理
+    if (!isMapped()) {
+        // 复制模式数据已在内存中，越界类型的文件整体拒绝；块内填充区也一并检查
+        size_t bytes = dataBytes();
+        for (size_t i = 0; i < bytes; i++) {
+            if ((cells[i] & kTypeMask) > kMaxType) return false;
+        }
+    }
+    return isNode(header.currentRow, header.currentCol);
+}
+
+void MapStore::swap(MapStore &other)
+{
+    // vector和unique_ptr交换不移动缓冲区，cells仍指向各自的数据
+    std::swap(header, other.header);
+    std::swap(chunkRows, other.chunkRows);
+    std::swap(chunkCount, other.chunkCount);
+    storage.swap(other.storage);
+    std::swap(cells, other.cells);
+    std::swap(mappedBase, other.mappedBase);
+    mappedFile.swap(other.mappedFile);
+    dirtyChunks.swap(other.dirtyChunks);
+    std::swap(headerDirty, other.headerDirty);
+    std::swap(backingPath, other.backingPath);
+}
+
+bool MapStore::load(const QString &path, LoadMode mode)
+{
+    std::unique_ptr<QFile> file(new QFile(path));
+    QIODevice::OpenMode openMode = mode == LoadMode::Mapped ? QIODevice::ReadWrite : QIODevice::ReadOnly;
+    if (!file->open(openMode)) {
+        qDebug() << "Cannot open map file:" << path;
+        return false;
+    }
+
+    Header fileHeader;
+    if (file->read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) != sizeof(fileHeader) ||
+        !validHeader(fileHeader, file->size())) {
+        qDebug() << "Invalid map file:" << path;
+        return false;
+    }
+
+    // 先读入临时对象，校验通过后再换入；失败时临时对象析构，当前地图不受影响
+    MapStore loaded;
+    loaded.header = fileHeader;
+    loaded.resetLayout(fileHeader.rows, fileHeader.cols);
+
+    if (mode == LoadMode::Mapped) {
+        uchar *base = file->map(0, file->size());
+        if (!base) {
+            qDebug() << "Cannot map map file:" << path;
+            return false;
+        }
+        // 数据直接使用映射区，首次访问时才从磁盘读入
+        loaded.storage.clear();
+        loaded.storage.shrink_to_fit();
+        loaded.mappedBase = base;
+        loaded.cells = base + kHeaderBytes;
+        loaded.mappedFile = std::move(file);
+    } else {
+        if (!file->seek(kHeaderBytes) ||
+            file->read(reinterpret_cast<char*>(loaded.cells), static_cast<qint64>(loaded.dataBytes())) !=
+                static_cast<qint64>(loaded.dataBytes())) {
+            qDebug() << "Truncated map file:" << path;
+            return false;
+        }
+    }
+
+    if (!loaded.validCells()) {
+        qDebug() << "Invalid map file:" << path;
+        return false;
+    }
+
+    loaded.backingPath = path;
+    std::fill(loaded.dirtyChunks.begin(), loaded.dirtyChunks.end(), 0);
+    loaded.headerDirty = false;
+    swap(loaded);
+    return true;
+}
@@ -0,0 +1,129 @@
+#ifndef MAPSTORE_H
+#define MAPSTORE_H
+
+#include "MapGenerator.h"
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+// 紧凑地图存储：每个格子一个字节（低4位类型，bit4已访问，bit5已解锁）
+// 数据按64x64的块排列（块内列优先），文件格式与内存布局完全一致：
+// 4KB文件头 + 按块顺序排列的4KB数据块，可以直接内存映射，保存时只写脏块
+// 4096x4096的地图占16MB
+class MapStore
+{
+public:
+    enum class LoadMode {
+        Copy,       // 读入内存
+        Mapped      // 内存映射，按需分页读入，修改直接写回文件；格子类型在读取时检查，不在载入时整体扫描
+    };
+
+    static constexpr int kChunkShift = 6;
+    static constexpr int kChunkSize = 1 << kChunkShift;
+    static constexpr int kChunkBytes = kChunkSize * kChunkSize;
+    static constexpr int kHeaderBytes = 4096;
+
+    MapStore();
+    ~MapStore();
+    MapStore(const MapStore &) = delete;
+    MapStore& operator=(const MapStore &) = delete;
+
+    void assign(const GeneratedMap &map, uint64_t seed);
+    void clear();
+
+    int rows() const { return header.rows; }
+    int cols() const { return header.cols; }
+    int startRow() const { return header.startRow; }
+    int startCol() const { return header.startCol; }
+    int bossRow() const { return header.bossRow; }
+    int bossCol() const { return header.bossCol; }
+    uint64_t seed() const { return header.seed; }
+
+    bool contains(int row, int col) const {
+        return row >= 0 && row < header.rows && col >= 0 && col < header.cols;
+    }
+    NodeType type(int row, int col) const { return static_cast<NodeType>(cellType(cells[offset(row, col)])); }
+    bool isNode(int row, int col) const { return contains(row, col) && cellType(cells[offset(row, col)]) != 0; }
+    bool isVisited(int row, int col) const { return cells[offset(row, col)] & kVisitedBit; }
+    bool isUnlocked(int row, int col) const { return cells[offset(row, col)] & kUnlockedBit; }
+    void setVisited(int row, int col, bool visited) { setBit(row, col, kVisitedBit, visited); }
+    void setUnlocked(int row, int col, bool unlocked) { setBit(row, col, kUnlockedBit, unlocked); }
+
+    // 存档进度：当前所在节点
+    void setCurrent(int row, int col);
+    int currentRow() const { return header.currentRow; }
+    int currentCol() const { return header.currentCol; }
+
+    // 同一文件再次保存时只写文件头和脏块；其他情况写完整文件
+    bool save(const QString &path);
+    // 失败时当前地图保持不变
+    bool load(const QString &path, LoadMode mode = LoadMode::Copy);
+
+    bool isMapped() const { return mappedBase != nullptr; }
+    int dirtyChunkCount() const;
+    size_t memoryBytes() const;
+
+private:
+    static constexpr uint8_t kTypeMask = 0x0F;
+    static constexpr uint8_t kVisitedBit = 0x10;
+    static constexpr uint8_t kUnlockedBit = 0x20;
+    static constexpr uint8_t kMaxType = static_cast<uint8_t>(NodeType::Boss);
+
+    // 类型用作查表下标，映射文件里超出范围的类型按空格子处理
+    static uint8_t cellType(uint8_t cell) {
+        uint8_t type = cell & kTypeMask;
+        return type <= kMaxType ? type : 0;
+    }
+
+    // 文件头（小端，定长字段）
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t seed;
+        int32_t rows;
+        int32_t cols;
+        int32_t chunkSize;
+        int32_t startRow;
+        int32_t startCol;
+        int32_t bossRow;
+        int32_t bossCol;
+        int32_t currentRow;
+        int32_t currentCol;
+    };
+
+    size_t chunkIndex(int row, int col) const {
+        return static_cast<size_t>(col >> kChunkShift) * chunkRows + (row >> kChunkShift);
+    }
+    size_t offset(int row, int col) const {
+        return (chunkIndex(row, col) << (2 * kChunkShift)) |
+               (static_cast<size_t>(col & (kChunkSize - 1)) << kChunkShift) |
+               static_cast<size_t>(row & (kChunkSize - 1));
+    }
+    void setBit(int row, int col, uint8_t bit, bool value);
+    void resetLayout(int rows, int cols);
+    size_t dataBytes() const { return chunkCount * static_cast<size_t>(kChunkBytes); }
+    bool validHeader(const Header &candidate, qint64 fileSize) const;
+    bool validCells() const;
+    void swap(MapStore &other);
+    bool writeFull(const QString &path);
+    bool writeIncremental();
+    void unmap();
+
+    Header header;
+    size_t chunkRows;
+    size_t chunkCount;
+
+    std::vector<uint8_t> storage;       // Copy模式下的数据
+    uint8_t *cells;                     // 指向storage或映射区
+    uint8_t *mappedBase;                // 映射区起点（文件头）
+    std::unique_ptr<QFile> mappedFile;
+
+    std::vector<uint8_t> dirtyChunks;
+    bool headerDirty;
+    QString backingPath;                // 与内存内容一致的文件
+};
+
+#endif // MAPSTORE_H
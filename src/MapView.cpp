@@ -0,0 +1,706 @@
+#include "MapView.h"
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QPainter>
+#include <QFont>
+#include <QWheelEvent>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int kTypeCount = static_cast<int>(NodeType::Boss) + 1;
+const int kGlyphCellSize = 64;
+const int kDefaultTileSize = 16;
+
+// 细节层次阈值（每格像素数）
+const float kGlyphMinPixels = 24.0f;
+const float kPointMinPixels = 3.0f;
+const float kEdgeMinPixels = 6.0f;
+
+// 最近时一屏显示的格子数
+const float kMinVisibleCells = 4.0f;
+const float kCameraSmoothing = 12.0f;
+
+// 与MapScreen::drawNode的配色一致
+const QVector3D kTypeColors[kTypeCount] = {
+    QVector3D(0.0f, 0.0f, 0.0f),            // Empty
+    QVector3D(100, 200, 100) / 255.0f,      // Start
+    QVector3D(200, 100, 100) / 255.0f,      // Combat
+    QVector3D(220, 60, 60) / 255.0f,        // Elite
+    QVector3D(100, 100, 200) / 255.0f,      // Shop
+    QVector3D(200, 200, 100) / 255.0f,      // Tavern
+    QVector3D(200, 100, 200) / 255.0f,      // Event
+    QVector3D(255, 215, 0) / 255.0f,        // Treasure
+    QVector3D(150, 50, 50) / 255.0f         // Boss
+};
+
+const char *const kTypeGlyphs[kTypeCount] = {
+    "", "S", "⚔", "☠", "$", "🍺", "?", "💎", "👑"
+};
+
+// 所有实例共用的单位四边形（三角形带）
+const GLfloat kUnitQuad[] = {
+    0.0f, 0.0f,
+    1.0f, 0.0f,
+    0.0f, 1.0f,
+    1.0f, 1.0f
+};
+
+const char *const kNodeVertexShader = R"(#version 330 core
+    layout(location = 0) in vec2 corner;
+    layout(location = 2) in vec2 cell;
+    layout(location = 3) in uint flags;
+    uniform mat4 projection;
+    uniform float nodeScale;
+    out vec2 local;
+    flat out uint nodeFlags;
+    void main() {
+        local = corner * 2.0 - 1.0;
+        vec2 world = vec2(cell.x, -cell.y) + local * 0.5 * nodeScale;
+        gl_Position = projection * vec4(world, 0.0, 1.0);
+        nodeFlags = flags;
+    }
+)";
+
+const char *const kNodeFragmentShader = R"(#version 330 core
+    in vec2 local;
+    flat in uint nodeFlags;
+    uniform vec3 typeColors[9];
+    uniform sampler2D glyphAtlas;
+    uniform int showGlyphs;
+    out vec4 fragColor;
+    void main() {
+        float d = length(local);
+        if (d > 1.0) discard;
+
+        uint type = nodeFlags & 15u;
+        vec3 base = typeColors[type];
+        vec3 color;
+        if ((nodeFlags & 16u) != 0u) {
+            color = min(base * 1.3, vec3(1.0));            // 已访问
+        } else if ((nodeFlags & 32u) != 0u) {
+            color = base;                                   // 已解锁
+        } else {
+            color = mix(vec3(0.31, 0.31, 0.39), base, 0.35); // 未解锁
+        }
+
+        if (d > 0.8) color *= 0.6;
+        if ((nodeFlags & 64u) != 0u && d > 0.75) color = vec3(1.0, 1.0, 0.4);
+
+        if (showGlyphs != 0) {
+            vec2 uv = vec2((float(type) + local.x * 0.5 + 0.5) / 9.0, 0.5 - local.y * 0.5);
+            vec4 glyph = texture(glyphAtlas, uv);
+            color = mix(color, glyph.rgb, glyph.a);
+        }
+
+        float alpha = 1.0 - smoothstep(1.0 - fwidth(d), 1.0, d);
+        fragColor = vec4(color, alpha);
+    }
+)";
+
+const char *const kEdgeVertexShader = R"(#version 330 core
+    layout(location = 0) in vec2 corner;
+    layout(location = 2) in vec3 edge;
+    uniform mat4 projection;
+    uniform float lineWidth;
+    void main() {
+        vec2 a = vec2(edge.x, -edge.y);
+        vec2 b = vec2(edge.x + 1.0, -(edge.y + edge.z));
+        vec2 dir = normalize(b - a);
+        vec2 normal = vec2(-dir.y, dir.x);
+        vec2 world = mix(a, b, corner.x) + normal * (corner.y - 0.5) * lineWidth;
+        gl_Position = projection * vec4(world, 0.0, 1.0);
+    }
+)";
+
+const char *const kEdgeFragmentShader = R"(#version 330 core
+    uniform vec4 color;
+    out vec4 fragColor;
+    void main() {
+        fragColor = color;
+    }
+)";
+
+const char *const kTileVertexShader = R"(#version 330 core
+    layout(location = 0) in vec2 corner;
+    layout(location = 2) in vec2 tile;
+    layout(location = 3) in uint flags;
+    uniform mat4 projection;
+    uniform float tileSize;
+    flat out uint tileFlags;
+    void main() {
+        vec2 cell = (tile + corner) * tileSize - 0.5;
+        gl_Position = projection * vec4(cell.x, -cell.y, 0.0, 1.0);
+        tileFlags = flags;
+    }
+)";
+
+const char *const kTileFragmentShader = R"(#version 330 core
+    flat in uint tileFlags;
+    uniform vec3 typeColors[9];
+    out vec4 fragColor;
+    void main() {
+        vec3 color = typeColors[tileFlags & 15u];
+        color *= (tileFlags & 16u) != 0u ? 1.2 : 0.8;
+        float density = float((tileFlags >> 8) & 255u) / 255.0;
+        fragColor = vec4(min(color, vec3(1.0)), density);
+    }
+)";
+}
+
+MapView::MapView(QWidget *parent)
+    : BaseRenderer(parent)
+    , mapRows(0)
+    , mapCols(0)
+    , tileSize(kDefaultTileSize)
+    , instancesDirty(false)
+    , currentInstance(-1)
+    , unitQuadVBO(QOpenGLBuffer::VertexBuffer)
+    , nodeVBO(QOpenGLBuffer::VertexBuffer)
+    , edgeVBO(QOpenGLBuffer::VertexBuffer)
+    , tileVBO(QOpenGLBuffer::VertexBuffer)
+    , glyphTexture(0)
+    , glReady(false)
+    , targetZoom(1.0f)
+    , dragging(false)
+{
+    setMouseTracking(false);
+}
+
+MapView::~MapView()
+{
+    makeCurrent();
+
+    nodeVAO.destroy();
+    edgeVAO.destroy();
+    tileVAO.destroy();
+    unitQuadVBO.destroy();
+    nodeVBO.destroy();
+    edgeVBO.destroy();
+    tileVBO.destroy();
+    deleteTexture(glyphTexture);
+
+    doneCurrent();
+}
+
+void MapView::setMap(const MapStore &store)
+{
+    mapRows = store.rows();
+    mapCols = store.cols();
+
+    // 节点和连线按列排序，可见列对应一段连续的实例
+    nodes.clear();
+    edges.clear();
+    nodeColumnOffsets.assign(mapCols + 1, 0);
+    edgeColumnOffsets.assign(mapCols + 1, 0);
+    for (int col = 0; col < mapCols; col++) {
+        nodeColumnOffsets[col] = static_cast<int>(nodes.size());
+        edgeColumnOffsets[col] = static_cast<int>(edges.size());
+        for (int row = 0; row < mapRows; row++) {
+            NodeType type = store.type(row, col);
+            if (type == NodeType::Empty) continue;
+
+            quint32 flags = static_cast<quint32>(type);
+            if (store.isVisited(row, col)) flags |= Visited;
+            if (store.isUnlocked(row, col)) flags |= Unlocked;
+            nodes.push_back({float(col), float(row), flags});
+            for (int d = -1; d <= 1; d++) {
+                if (store.isNode(row + d, col + 1)) {
+                    edges.push_back({float(col), float(row), float(d)});
+                }
+            }
+        }
+    }
+    nodeColumnOffsets[mapCols] = static_cast<int>(nodes.size());
+    edgeColumnOffsets[mapCols] = static_cast<int>(edges.size());
+
+    // 远景聚合：每tileSize x tileSize个格子合成一块
+    int tileCols = (mapCols + tileSize - 1) / tileSize;
+    int tileRows = (mapRows + tileSize - 1) / tileSize;
+    tiles.clear();
+    tileColumnOffsets.assign(tileCols + 1, 0);
+    for (int tc = 0; tc < tileCols; tc++) {
+        tileColumnOffsets[tc] = static_cast<int>(tiles.size());
+        for (int tr = 0; tr < tileRows; tr++) {
+            int counts[kTypeCount] = {};
+            int total = 0;
+            bool visited = false;
+            int colEnd = std::min(mapCols, (tc + 1) * tileSize);
+            int rowEnd = std::min(mapRows, (tr + 1) * tileSize);
+            for (int col = tc * tileSize; col < colEnd; col++) {
+                for (int row = tr * tileSize; row < rowEnd; row++) {
+                    NodeType type = store.type(row, col);
+                    if (type == NodeType::Empty) continue;
+                    counts[static_cast<int>(type)]++;
+                    total++;
+                    visited = visited || store.isVisited(row, col);
+                }
+            }
+            if (total == 0) continue;
+
+            // 起点和Boss在远处也要能看到
+            int dominant = static_cast<int>(NodeType::Combat);
+            if (counts[static_cast<int>(NodeType::Boss)]) {
+                dominant = static_cast<int>(NodeType::Boss);
+            } else if (counts[static_cast<int>(NodeType::Start)]) {
+                dominant = static_cast<int>(NodeType::Start);
+            } else {
+                for (int t = 1; t < kTypeCount; t++) {
+                    if (counts[t] > counts[dominant]) dominant = t;
+                }
+            }
+
+            // 路径通常只占少量格子，放大密度让稀疏区块也可见
+            int density = std::min(255, 64 + total * 4 * 191 / (tileSize * tileSize));
+            quint32 flags = static_cast<quint32>(dominant) | (quint32(density) << 8);
+            if (visited) flags |= Visited;
+            tiles.push_back({float(tc), float(tr), flags});
+        }
+    }
+    tileColumnOffsets[tileCols] = static_cast<int>(tiles.size());
+
+    currentInstance = -1;
+    instancesDirty = true;
+
+    // 新地图直接显示全貌，不做动画
+    clampZoomRange();
+    zoomToFit();
+    setCameraZoom(targetZoom);
+    setCameraPosition(targetPosition);
+}
+
+int MapView::findNodeInstance(int row, int col) const
+{
+    if (col < 0 || col >= mapCols) return -1;
+
+    // 列内按行有序，二分查找
+    auto first = nodes.begin() + nodeColumnOffsets[col];
+    auto last = nodes.begin() + nodeColumnOffsets[col + 1];
+    auto it = std::lower_bound(first, last, float(row),
+                               [](const NodeInstance &node, float r) { return node.row < r; });
+    if (it == last || it->row != float(row)) return -1;
+    return static_cast<int>(it - nodes.begin());
+}
+
+int MapView::findTileInstance(int tileRow, int tileCol) const
+{
+    if (tileCol < 0 || tileCol + 1 >= static_cast<int>(tileColumnOffsets.size())) return -1;
+
+    auto first = tiles.begin() + tileColumnOffsets[tileCol];
+    auto last = tiles.begin() + tileColumnOffsets[tileCol + 1];
+    auto it = std::lower_bound(first, last, float(tileRow),
+                               [](const TileInstance &tile, float r) { return tile.row < r; });
+    if (it == last || it->row != float(tileRow)) return -1;
+    return static_cast<int>(it - tiles.begin());
+}
+
+void MapView::setNodeState(int row, int col, bool visited, bool unlocked)
+{
+    int index = findNodeInstance(row, col);
+    if (index < 0) return;
+
+    NodeInstance &node = nodes[index];
+    quint32 flags = node.flags & ~quint32(Visited | Unlocked);
+    if (visited) flags |= Visited;
+    if (unlocked) flags |= Unlocked;
+    if (flags == node.flags) return;
+
+    node.flags = flags;
+    writeInstance(nodeVBO, index * sizeof(NodeInstance), &node, sizeof(NodeInstance));
+
+    // 区块记录是否包含已访问节点
+    if (visited) {
+        int tile = findTileInstance(row / tileSize, col / tileSize);
+        if (tile >= 0 && !(tiles[tile].flags & Visited)) {
+            tiles[tile].flags |= Visited;
+            writeInstance(tileVBO, tile * sizeof(TileInstance), &tiles[tile], sizeof(TileInstance));
+        }
+    }
+    update();
+}
+
+void MapView::setCurrentNode(int row, int col)
+{
+    int index = findNodeInstance(row, col);
+    if (index == currentInstance) return;
+
+    if (currentInstance >= 0) {
+        nodes[currentInstance].flags &= ~quint32(Current);
+        writeInstance(nodeVBO, currentInstance * sizeof(NodeInstance),
+                      &nodes[currentInstance], sizeof(NodeInstance));
+    }
+    currentInstance = index;
+    if (currentInstance >= 0) {
+        nodes[currentInstance].flags |= Current;
+        writeInstance(nodeVBO, currentInstance * sizeof(NodeInstance),
+                      &nodes[currentInstance], sizeof(NodeInstance));
+    }
+    update();
+}
+
+void MapView::writeInstance(QOpenGLBuffer &buffer, int offset, const void *data, int size)
+{
+    // 整体上传之前只改CPU端数据
+    if (!glReady || instancesDirty) return;
+
+    makeCurrent();
+    buffer.bind();
+    buffer.write(offset, data, size);
+    buffer.release();
+    doneCurrent();
+}
+
+void MapView::centerOn(int row, int col)
+{
+    targetPosition = QVector2D(float(col), -float(row));
+    FrameScheduler::instance()->wake(this);
+}
+
+void MapView::zoomToFit()
+{
+    targetZoom = minCameraZoom;
+    targetPosition = QVector2D((mapCols - 1) * 0.5f, -(mapRows - 1) * 0.5f);
+    FrameScheduler::instance()->wake(this);
+}
+
+void MapView::clampZoomRange()
+{
+    if (mapRows <= 0 || mapCols <= 0) return;
+
+    // 最远能看到整张地图，最近一屏kMinVisibleCells个格子
+    float aspect = aspectRatio > 0.0f ? aspectRatio : 1.0f;
+    float fitHeight = std::max(float(mapRows), mapCols / aspect) * 1.05f + 2.0f;
+    float maxZoom = 10.0f / kMinVisibleCells;
+    setCameraZoomRange(std::min(10.0f / fitHeight, maxZoom), maxZoom);
+    targetZoom = std::max(minCameraZoom, std::min(targetZoom, maxCameraZoom));
+}
+
+float MapView::pixelsPerCell() const
+{
+    return height() * cameraZoom / 10.0f;
+}
+
+MapView::DetailLevel MapView::detailLevel() const
+{
+    float pixels = pixelsPerCell();
+    if (pixels >= kGlyphMinPixels) return DetailLevel::Glyphs;
+    if (pixels >= kPointMinPixels) return DetailLevel::Points;
+    return DetailLevel::Tiles;
+}
+
+void MapView::initializeGL()
+{
+    BaseRenderer::initializeGL();
+    glClearColor(30 / 255.0f, 30 / 255.0f, 45 / 255.0f, 1.0f);
+
+    registerShaders();
+
+    unitQuadVBO.create();
+    unitQuadVBO.bind();
+    unitQuadVBO.allocate(kUnitQuad, sizeof(kUnitQuad));
+    unitQuadVBO.release();
+
+    for (QOpenGLBuffer *buffer : {&nodeVBO, &edgeVBO, &tileVBO}) {
+        buffer->create();
+        buffer->setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    }
+    setupInstanceVAO(nodeVAO, nodeVBO);
+    setupInstanceVAO(edgeVAO, edgeVBO);
+    setupInstanceVAO(tileVAO, tileVBO);
+
+    createGlyphAtlas();
+
+    glReady = true;
+    instancesDirty = true;
+}
+
+void MapView::registerShaders()
+{
+    registerGlobalShader("mapNode", kNodeVertexShader, kNodeFragmentShader);
+    registerGlobalShader("mapEdge", kEdgeVertexShader, kEdgeFragmentShader);
+    registerGlobalShader("mapTile", kTileVertexShader, kTileFragmentShader);
+}
+
+void MapView::createGlyphAtlas()
+{
+    // 所有类型的图标排成一行，着色器按类型取对应格子
+    QImage atlas(kGlyphCellSize * kTypeCount, kGlyphCellSize, QImage::Format_RGBA8888);
+    atlas.fill(Qt::transparent);
+
+    QPainter painter(&atlas);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    QFont font("Arial", 12, QFont::Bold);
+    font.setPixelSize(kGlyphCellSize / 2);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    for (int t = 1; t < kTypeCount; t++) {
+        QRect cell(t * kGlyphCellSize, 0, kGlyphCellSize, kGlyphCellSize);
+        painter.drawText(cell, Qt::AlignCenter, QString::fromUtf8(kTypeGlyphs[t]));
+    }
+    painter.end();
+
+    createTextureFromImage(atlas, glyphTexture, GL_LINEAR, GL_LINEAR);
+}
+
+void MapView::setupInstanceVAO(QOpenGLVertexArrayObject &vao, QOpenGLBuffer &buffer)
+{
+    QOpenGLExtraFunctions *f = context()->extraFunctions();
+
+    vao.create();
+    vao.bind();
+
+    unitQuadVBO.bind();
+    f->glEnableVertexAttribArray(0);
+    f->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    f->glVertexAttribDivisor(0, 0);
+
+    // 实例属性的指针在绘制时按可见范围设置
+    buffer.bind();
+    f->glEnableVertexAttribArray(2);
+    f->glVertexAttribDivisor(2, 1);
+
+    vao.release();
+}
+
+void MapView::uploadInstances()
+{
+    auto upload = [](QOpenGLBuffer &buffer, const void *data, size_t bytes) {
+        buffer.bind();
+        buffer.allocate(data, static_cast<int>(bytes));
+        buffer.release();
+    };
+    upload(nodeVBO, nodes.data(), nodes.size() * sizeof(NodeInstance));
+    upload(edgeVBO, edges.data(), edges.size() * sizeof(EdgeInstance));
+    upload(tileVBO, tiles.data(), tiles.size() * sizeof(TileInstance));
+    instancesDirty = false;
+}
+
+void MapView::resizeGL(int w, int h)
+{
+    BaseRenderer::resizeGL(w, h);
+    clampZoomRange();
+    setCameraZoom(cameraZoom);
+}
+
+void MapView::updateViewMatrix()
+{
+    viewMatrix.setToIdentity();
+}
+
+void MapView::paintGL()
+{
+    if (instancesDirty) {
+        uploadInstances();
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    if (nodes.empty()) return;
+
+    float pixels = pixelsPerCell();
+    switch (detailLevel()) {
+        case DetailLevel::Tiles:
+            drawTiles();
+            break;
+        case DetailLevel::Points:
+            if (pixels >= kEdgeMinPixels) drawEdges();
+            // 节点至少保持约2.5像素
+            drawNodes(false, std::min(1.0f, std::max(0.7f, 2.5f / pixels)));
+            break;
+        case DetailLevel::Glyphs:
+            drawEdges();
+            drawNodes(true, 0.6f);
+            break;
+    }
+}
+
+void MapView::visibleColumns(int cellsPerColumn, int &first, int &last) const
+{
+    float viewHeight = 10.0f / cameraZoom;
+    float viewWidth = viewHeight * aspectRatio;
+    float left = cameraPosition.x() - viewWidth / 2;
+    float right = cameraPosition.x() + viewWidth / 2;
+
+    // 多留一列，覆盖节点半径和跨列的连线
+    int columns = (mapCols + cellsPerColumn - 1) / cellsPerColumn;
+    first = std::max(0, static_cast<int>(std::floor((left + 0.5f) / cellsPerColumn)) - 1);
+    last = std::min(columns - 1, static_cast<int>(std::floor((right + 0.5f) / cellsPerColumn)) + 1);
+}
+
+void MapView::drawInstances(QOpenGLVertexArrayObject &vao, QOpenGLBuffer &buffer,
+                            const std::vector<int> &columnOffsets, int stride, int positionComponents,
+                            bool hasFlags, int firstColumn, int lastColumn)
+{
+    if (firstColumn > lastColumn) return;
+    int firstInstance = columnOffsets[firstColumn];
+    int count = columnOffsets[lastColumn + 1] - firstInstance;
+    if (count <= 0) return;
+
+    QOpenGLExtraFunctions *f = context()->extraFunctions();
+    vao.bind();
+    buffer.bind();
+
+    // 把实例属性指向可见范围的第一个实例，一次绘制调用提交整段
+    const char *base = reinterpret_cast<const char*>(static_cast<quintptr>(firstInstance) * stride);
+    f->glVertexAttribPointer(2, positionComponents, GL_FLOAT, GL_FALSE, stride, base);
+    if (hasFlags) {
+        f->glEnableVertexAttribArray(3);
+        f->glVertexAttribDivisor(3, 1);
+        f->glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, stride, base + 2 * sizeof(float));
+    }
+    f->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+
+    buffer.release();
+    vao.release();
+}
+
+void MapView::drawNodes(bool glyphs, float nodeScale)
+{
+    QOpenGLShaderProgram *shader = getGlobalShader("mapNode");
+    if (!shader) return;
+
+    int first, last;
+    visibleColumns(1, first, last);
+
+    shader->bind();
+    shader->setUniformValue("projection", projectionMatrix);
+    shader->setUniformValue("nodeScale", nodeScale);
+    shader->setUniformValueArray("typeColors", kTypeColors, kTypeCount);
+    shader->setUniformValue("showGlyphs", glyphs ? 1 : 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, glyphTexture);
+    shader->setUniformValue("glyphAtlas", 0);
+
+    drawInstances(nodeVAO, nodeVBO, nodeColumnOffsets, sizeof(NodeInstance), 2, true, first, last);
+
+    shader->release();
+}
+
+void MapView::drawEdges()
+{
+    QOpenGLShaderProgram *shader = getGlobalShader("mapEdge");
+    if (!shader) return;
+
+    int first, last;
+    visibleColumns(1, first, last);
+
+    // 线宽至少1.5像素
+    float lineWidth = std::max(0.08f, 1.5f / pixelsPerCell());
+    shader->bind();
+    shader->setUniformValue("projection", projectionMatrix);
+    shader->setUniformValue("lineWidth", lineWidth);
+    shader->setUniformValue("color", QVector4D(100 / 255.0f, 150 / 255.0f, 200 / 255.0f, 150 / 255.0f));
+
+    drawInstances(edgeVAO, edgeVBO, edgeColumnOffsets, sizeof(EdgeInstance), 3, false, first, last);
+
+    shader->release();
+}
+
+void MapView::drawTiles()
+{
+    QOpenGLShaderProgram *shader = getGlobalShader("mapTile");
+    if (!shader) return;
+
+    int first, last;
+    visibleColumns(tileSize, first, last);
+
+    shader->bind();
+    shader->setUniformValue("projection", projectionMatrix);
+    shader->setUniformValue("tileSize", float(tileSize));
+    shader->setUniformValueArray("typeColors", kTypeColors, kTypeCount);
+
+    drawInstances(tileVAO, tileVBO, tileColumnOffsets, sizeof(TileInstance), 2, true, first, last);
+
+    shader->release();
+}
+
+bool MapView::tick(float deltaTime)
+{
+    float zoomError = std::fabs(std::log(targetZoom / cameraZoom));
+    float positionError = (targetPosition - cameraPosition).length() * cameraZoom;
+    if (zoomError < 1e-3f && positionError < 1e-3f) {
+        return false;
+    }
+
+    // 指数逼近，缩放在对数空间插值，速度与缩放级别无关
+    float t = 1.0f - std::exp(-kCameraSmoothing * deltaTime);
+    if (zoomError < 1e-3f) {
+        cameraZoom = targetZoom;
+    } else {
+        cameraZoom = std::exp(std::log(cameraZoom) + (std::log(targetZoom) - std::log(cameraZoom)) * t);
+    }
+    if (positionError < 1e-3f) {
+        setCameraPosition(targetPosition);
+    } else {
+        setCameraPosition(cameraPosition + (targetPosition - cameraPosition) * t);
+    }
+    setCameraZoom(cameraZoom);
+    return true;
+}
+
+QPointF MapView::screenToWorld(const QPointF &pos) const
+{
+    float viewHeight = 10.0f / cameraZoom;
+    float viewWidth = viewHeight * aspectRatio;
+    return QPointF(cameraPosition.x() + (pos.x() / width() - 0.5) * viewWidth,
+                   cameraPosition.y() + (0.5 - pos.y() / height()) * viewHeight);
+}
+
+void MapView::mousePressEvent(QMouseEvent *event)
+{
+    BaseRenderer::mousePressEvent(event);
+
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        pressPos = event->position();
+        lastDragPos = pressPos;
+    }
+}
+
+void MapView::mouseMoveEvent(QMouseEvent *event)
+{
+    BaseRenderer::mouseMoveEvent(event);
+    if (!dragging) return;
+
+    // 拖拽直接移动相机，不做平滑
+    QPointF delta = event->position() - lastDragPos;
+    lastDragPos = event->position();
+    float worldPerPixel = (10.0f / cameraZoom) / std::max(1, height());
+    QVector2D position = cameraPosition + QVector2D(-delta.x(), delta.y()) * worldPerPixel;
+    targetPosition = position;
+    setCameraPosition(position);
+}
+
+void MapView::mouseReleaseEvent(QMouseEvent *event)
+{
+    BaseRenderer::mouseReleaseEvent(event);
+    if (event->button() != Qt::LeftButton || !dragging) return;
+    dragging = false;
+
+    // 几乎没有移动时当作点击
+    if ((event->position() - pressPos).manhattanLength() > 4) return;
+
+    QPointF world = screenToWorld(event->position());
+    int col = static_cast<int>(std::lround(world.x()));
+    int row = static_cast<int>(std::lround(-world.y()));
+    if (findNodeInstance(row, col) >= 0) {
+        emit nodeClicked(row, col);
+    }
+}
+
+void MapView::wheelEvent(QWheelEvent *event)
+{
+    float steps = event->angleDelta().y() / 120.0f;
+    if (steps == 0.0f) return;
+
+    // 以光标所在位置为锚点缩放
+    float newZoom = std::max(minCameraZoom, std::min(targetZoom * std::pow(1.25f, steps), maxCameraZoom));
+    QPointF anchor = screenToWorld(event->position());
+    QVector2D anchorWorld(anchor.x(), anchor.y());
+    targetPosition = anchorWorld + (targetPosition - anchorWorld) * (targetZoom / newZoom);
+    targetZoom = newZoom;
+
+    FrameScheduler::instance()->wake(this);
+    event->accept();
+}
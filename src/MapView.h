@@ -0,0 +1,138 @@
+#ifndef MAPVIEW_H
+#define MAPVIEW_H
+
+#include "BaseRenderer.h"
+#include "MapStore.h"
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QPointF>
+#include <vector>
+
+// GPU地图视图：节点、连线和区域块都用实例化绘制，只提交可见列
+// 世界坐标中一个格子为1个单位，x = col，y = -row
+// 细节层次按每格像素数切换：近处画图标，中间画色点，远处画聚合区块
+class MapView : public BaseRenderer
+{
+    Q_OBJECT
+
+public:
+    enum class DetailLevel {
+        Glyphs,     // 节点圆 + 图标 + 连线
+        Points,     // 节点色点 + 连线
+        Tiles       // 区域聚合块
+    };
+
+    explicit MapView(QWidget *parent = nullptr);
+    ~MapView();
+
+    // 节点状态一并取自store（读档后直接显示进度）
+    void setMap(const MapStore &store);
+    void setNodeState(int row, int col, bool visited, bool unlocked);
+    void setCurrentNode(int row, int col);
+
+    // 平滑移动到目标位置/缩放（由tick插值）
+    void centerOn(int row, int col);
+    void zoomToFit();
+
+    DetailLevel detailLevel() const;
+    float pixelsPerCell() const;
+
+signals:
+    void nodeClicked(int row, int col);
+
+protected:
+    void initializeGL() override;
+    void resizeGL(int w, int h) override;
+    void paintGL() override;
+
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+    // 投影矩阵已经包含相机位置，这里不再平移
+    void updateViewMatrix() override;
+    bool tick(float deltaTime) override;
+
+private:
+    // 每个节点一个实例：12字节
+    struct NodeInstance {
+        float col;
+        float row;
+        quint32 flags;      // 低4位类型，之后为状态位
+    };
+
+    // 每条连线一个实例：从(col, row)连到(col + 1, row + dRow)
+    struct EdgeInstance {
+        float col;
+        float row;
+        float dRow;
+    };
+
+    // 聚合区块：颜色取区块内最多的节点类型，透明度取节点密度
+    struct TileInstance {
+        float col;
+        float row;
+        quint32 flags;      // 低4位类型，8-15位密度
+    };
+
+    enum NodeFlag : quint32 {
+        TypeMask = 0x0F,
+        Visited = 0x10,
+        Unlocked = 0x20,
+        Current = 0x40
+    };
+
+    void registerShaders();
+    void createGlyphAtlas();
+    void uploadInstances();
+    void setupInstanceVAO(QOpenGLVertexArrayObject &vao, QOpenGLBuffer &buffer);
+    void drawNodes(bool glyphs, float nodeScale);
+    void drawEdges();
+    void drawTiles();
+    void drawInstances(QOpenGLVertexArrayObject &vao, QOpenGLBuffer &buffer,
+                       const std::vector<int> &columnOffsets, int stride, int positionComponents,
+                       bool hasFlags, int firstColumn, int lastColumn);
+
+    int findNodeInstance(int row, int col) const;
+    int findTileInstance(int tileRow, int tileCol) const;
+    void writeInstance(QOpenGLBuffer &buffer, int offset, const void *data, int size);
+    void visibleColumns(int cellsPerColumn, int &first, int &last) const;
+    QPointF screenToWorld(const QPointF &pos) const;
+    void clampZoomRange();
+
+    int mapRows;
+    int mapCols;
+    int tileSize;
+
+    // CPU端实例数据，按列排序；columnOffsets[c]是第c列的第一个实例
+    std::vector<NodeInstance> nodes;
+    std::vector<EdgeInstance> edges;
+    std::vector<TileInstance> tiles;
+    std::vector<int> nodeColumnOffsets;
+    std::vector<int> edgeColumnOffsets;
+    std::vector<int> tileColumnOffsets;
+    bool instancesDirty;
+    int currentInstance;
+
+    QOpenGLBuffer unitQuadVBO;
+    QOpenGLBuffer nodeVBO;
+    QOpenGLBuffer edgeVBO;
+    QOpenGLBuffer tileVBO;
+    QOpenGLVertexArrayObject nodeVAO;
+    QOpenGLVertexArrayObject edgeVAO;
+    QOpenGLVertexArrayObject tileVAO;
+    GLuint glyphTexture;
+    bool glReady;
+
+    // 平滑相机
+    QVector2D targetPosition;
+    float targetZoom;
+
+    // 拖拽
+    bool dragging;
+    QPointF pressPos;
+    QPointF lastDragPos;
+};
+
+#endif // MAPVIEW_H
@@ -0,0 +1,168 @@
+#include "SceneManager.h"
+#include "BossScene.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QPromise>
+#include <QDebug>
+
+SceneManager::SceneManager(QWidget *sceneParent, QObject *parent)
+    : QObject(parent)
+    , sceneParent(sceneParent)
+{
+}
+
+SceneManager::~SceneManager()
+{
+    // 等待后台任务结束，结果直接丢弃
+    for (QFutureWatcher<ResourceSet> *watcher : loaders) {
+        watcher->disconnect(this);
+        watcher->waitForFinished();
+    }
+    loaders.clear();
+}
+
+bool SceneManager::hasSceneFactory(GameSceneType type)
+{
+    switch (type) {
+    case GameSceneType::BOSS_BATTLE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SceneManager::preload(GameSceneType type, int level)
+{
+    if (!hasSceneFactory(type)) {
+        qWarning() << "No scene factory for type" << static_cast<int>(type);
+        return;
+    }
+    if (isReady(type) || isLoading(type)) {
+        return;
+    }
+
+    auto *watcher = new QFutureWatcher<ResourceSet>(this);
+    loaders[type] = watcher;
+
+    connect(watcher, &QFutureWatcherBase::progressValueChanged, this, [this, type](int value) {
+        emit loadProgress(type, value);
+    });
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, type, watcher]() {
+        loaders.remove(type);
+        watcher->deleteLater();
+
+        if (watcher->isCanceled() || watcher->future().resultCount() == 0) {
+            qWarning() << "Scene preload failed for type" << static_cast<int>(type);
+            pendingRequests.remove(type);
+            return;
+        }
+        onResourcesLoaded(type, watcher->result());
+    });
+
+    // 资源解码在线程池中进行，只使用QImage，不触碰OpenGL
+    watcher->setFuture(QtConcurrent::run([type, level](QPromise<ResourceSet> &promise) {
+        promise.setProgressRange(0, 100);
+
+        ResourceSet resources;
+        switch (type) {
+        case GameSceneType::BOSS_BATTLE:
+            resources = BossScene::loadResources(level, [&promise](int percent) {
+                promise.setProgressValue(percent);
+            });
+            break;
+        default:
+            break;
+        }
+
+        promise.setProgressValue(100);
+        promise.addResult(resources);
+    }));
+}
+
+void SceneManager::request(GameSceneType type, int level)
+{
+    if (isReady(type)) {
+        emit sceneReady(type, level, cache[type].widget);
+        return;
+    }
+
+    // 资源就绪后再切换
+    pendingRequests[type] = level;
+    preload(type, level);
+}
+
+void SceneManager::cancelRequest(GameSceneType type)
+{
+    pendingRequests.remove(type);
+}
+
+bool SceneManager::isReady(GameSceneType type) const
+{
+    auto it = cache.constFind(type);
+    return it != cache.constEnd() && it->ready && it->widget;
+}
+
+bool SceneManager::isLoading(GameSceneType type) const
+{
+    return loaders.contains(type);
+}
+
+QWidget* SceneManager::scene(GameSceneType type) const
+{
+    auto it = cache.constFind(type);
+    return it != cache.constEnd() ? it->widget.data() : nullptr;
+}
+
+void SceneManager::evict(GameSceneType type)
+{
+    auto it = cache.find(type);
+    if (it == cache.end()) return;
+
+    if (it->widget) {
+        it->widget->deleteLater();
+    }
+    cache.erase(it);
+}
+
+QWidget* SceneManager::createScene(GameSceneType type)
+{
+    QWidget *widget = nullptr;
+    switch (type) {
+    case GameSceneType::BOSS_BATTLE:
+        widget = new BossScene(sceneParent);
+        break;
+    default:
+        return nullptr;
+    }
+    
+    // 切换前保持隐藏，避免随父控件一起显示
+    widget->hide();
+    return widget;
+}
+
+void SceneManager::onResourcesLoaded(GameSceneType type, const ResourceSet &resources)
+{
+    CacheEntry &entry = cache[type];
+
+    // 场景实例只在GUI线程创建一次，之后复用
+    if (!entry.widget) {
+        entry.widget = createScene(type);
+        if (!entry.widget) {
+            cache.remove(type);
+            pendingRequests.remove(type);
+            return;
+        }
+        emit sceneCreated(type, entry.widget);
+    }
+
+    if (BaseRenderer *renderer = qobject_cast<BaseRenderer*>(entry.widget.data())) {
+        renderer->setPreloadedImages(resources);
+    }
+    entry.ready = true;
+
+    auto pending = pendingRequests.find(type);
+    if (pending != pendingRequests.end()) {
+        int requestedLevel = pending.value();
+        pendingRequests.erase(pending);
+        emit sceneReady(type, requestedLevel, entry.widget);
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef SCENEMANAGER_H
+#define SCENEMANAGER_H
+
+#include <QObject>
+#include <QWidget>
+#include <QMap>
+#include <QHash>
+#include <QImage>
+#include <QPointer>
+#include <QFutureWatcher>
+
+enum class GameSceneType {
+    NONE,
+    COMBAT,
+    PLATFORMER,
+    BOSS_BATTLE,
+    SHOP,
+    MENU
+};
+
+// 场景管理器：后台预加载资源，缓存场景实例
+class SceneManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SceneManager(QWidget *sceneParent, QObject *parent = nullptr);
+    ~SceneManager();
+
+    // 在后台线程解码场景资源（例如地图界面显示期间）
+    void preload(GameSceneType type, int level = 1);
+
+    // 请求场景，就绪后发出sceneReady；已缓存的场景立即就绪
+    void request(GameSceneType type, int level = 1);
+    void cancelRequest(GameSceneType type);
+
+    bool isReady(GameSceneType type) const;
+    bool isLoading(GameSceneType type) const;
+    QWidget* scene(GameSceneType type) const;
+
+    // 从缓存中移除并销毁场景
+    void evict(GameSceneType type);
+
+signals:
+    void loadProgress(GameSceneType type, int percent);
+    void sceneCreated(GameSceneType type, QWidget *scene);
+    void sceneReady(GameSceneType type, int level, QWidget *scene);
+
+private:
+    using ResourceSet = QHash<QString, QImage>;
+
+    struct CacheEntry {
+        QPointer<QWidget> widget;
+        bool ready = false;
+    };
+
+    QWidget* createScene(GameSceneType type);
+    void onResourcesLoaded(GameSceneType type, const ResourceSet &resources);
+    static bool hasSceneFactory(GameSceneType type);
+
+    QWidget *sceneParent;
+    QMap<GameSceneType, CacheEntry> cache;
+    QMap<GameSceneType, QFutureWatcher<ResourceSet>*> loaders;
+    QMap<GameSceneType, int> pendingRequests; // 等待就绪的请求（类型 -> 关卡）
+};
+
+#endif // SCENEMANAGER_H
@@ -0,0 +1,365 @@
+#include "SpineAllocator.h"
+#include <QDebug>
+#include <QHash>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+const size_t kArenaChunkSize = 64 * 1024;
+const size_t kPoolChunkSize = 64 * 1024;
+const size_t kAlignment = 16;
+
+// 固定块池的块大小（含头），覆盖spine运行时绝大多数对象和小数组
+const size_t kPoolBlockSizes[] = {32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512};
+
+thread_local SpineAllocator::Arena *currentArena = nullptr;
+
+size_t alignSize(size_t size)
+{
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+QString siteName(const char *file, int line)
+{
+    if (!file) return QStringLiteral("(other)");
+    const char *name = file;
+    for (const char *c = file; *c; c++) {
+        if (*c == '/' || *c == '\\') name = c + 1;
+    }
+    return QString::fromUtf8(name) + ":" + QString::number(line);
+}
+}
+
+SpineAllocator *SpineAllocator::current = nullptr;
+
+SpineAllocator::Arena::Arena(const QString &name)
+    : label(name)
+    , used(0)
+    , reserved(0)
+{
+    if (SpineAllocator *allocator = SpineAllocator::instance()) {
+        std::lock_guard<std::mutex> lock(allocator->arenaMutex);
+        allocator->arenas.push_back(this);
+    }
+}
+
+SpineAllocator::Arena::~Arena()
+{
+    if (SpineAllocator *allocator = SpineAllocator::instance()) {
+        std::lock_guard<std::mutex> lock(allocator->arenaMutex);
+        allocator->arenas.erase(std::remove(allocator->arenas.begin(), allocator->arenas.end(), this),
+                                allocator->arenas.end());
+    }
+    for (char *chunk : chunks) {
+        std::free(chunk);
+    }
+}
+
+char* SpineAllocator::Arena::allocate(size_t size)
+{
+    size = alignSize(size);
+    if (size > static_cast<size_t>(end - cursor)) {
+        // 大块单独占一个chunk，不浪费当前chunk的剩余空间
+        if (size > kArenaChunkSize / 4) {
+            char *block = static_cast<char*>(std::malloc(size));
+            if (!block) return nullptr;
+            chunks.push_back(block);
+            reserved.fetch_add(size, std::memory_order_relaxed);
+            used.fetch_add(size, std::memory_order_relaxed);
+            last = nullptr;
+            return block;
+        }
+
+        char *chunk = static_cast<char*>(std::malloc(kArenaChunkSize));
+        if (!chunk) return nullptr;
+        chunks.push_back(chunk);
+        reserved.fetch_add(kArenaChunkSize, std::memory_order_relaxed);
+        cursor = chunk;
+        end = chunk + kArenaChunkSize;
+    }
+
+    char *block = cursor;
+    cursor += size;
+    last = block;
+    used.fetch_add(size, std::memory_order_relaxed);
+    return block;
+}
+
+bool SpineAllocator::Arena::extend(char *block, size_t oldSize, size_t newSize)
+{
+    oldSize = alignSize(oldSize);
+    newSize = alignSize(newSize);
+    if (block != last || newSize > static_cast<size_t>(end - block)) return false;
+
+    // 加载时Vector逐个追加元素，最后分配的数组可以原地增长
+    cursor = block + newSize;
+    used.fetch_add(newSize - std::min(oldSize, newSize), std::memory_order_relaxed);
+    return true;
+}
+
+SpineAllocator::ArenaScope::ArenaScope(Arena *arena)
+    : previous(currentArena)
+{
+    currentArena = arena;
+}
+
+SpineAllocator::ArenaScope::~ArenaScope()
+{
+    currentArena = previous;
+}
+
+SpineAllocator::SpineAllocator()
+{
+    static_assert(sizeof(BlockHeader) <= kAlignment, "block header must keep user memory aligned");
+    static_assert(sizeof(kPoolBlockSizes) / sizeof(kPoolBlockSizes[0]) == kPoolCount, "pool count mismatch");
+
+    for (int i = 0; i < kPoolCount; i++) {
+        pools[i].blockSize = kPoolBlockSizes[i];
+    }
+    for (std::atomic<int64_t> &bytes : kindBytes) {
+        bytes.store(0, std::memory_order_relaxed);
+    }
+    // 下标0收容位置表溢出的分配
+    sites[0].used.store(true, std::memory_order_release);
+    current = this;
+}
+
+SpineAllocator::~SpineAllocator()
+{
+    if (current == this) current = nullptr;
+    for (Pool &pool : pools) {
+        for (char *chunk : pool.chunks) {
+            std::free(chunk);
+        }
+    }
+}
+
+SpineAllocator* SpineAllocator::instance()
+{
+    return current;
+}
+
+uint16_t SpineAllocator::siteIndex(const char *file, int line)
+{
+    // __FILE__是字面量，同一翻译单元内地址固定，直接按地址+行号查找；跨单元的同名文件在输出时合并
+    uintptr_t hash = (reinterpret_cast<uintptr_t>(file) >> 3) * 31u + static_cast<uintptr_t>(line);
+    hash ^= hash >> 13;
+    hash *= 0x9e3779b1u;
+    hash ^= hash >> 16;
+
+    for (int probe = 0; probe < kSiteCount; probe++) {
+        int index = static_cast<int>((hash + probe) & (kSiteCount - 1));
+        if (index == 0) continue;
+
+        Site &site = sites[index];
+        if (!site.used.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(siteMutex);
+            if (!site.used.load(std::memory_order_relaxed)) {
+                site.file = file;
+                site.line = line;
+                site.used.store(true, std::memory_order_release);
+                return static_cast<uint16_t>(index);
+            }
+        }
+        if (site.file == file && site.line == line) return static_cast<uint16_t>(index);
+    }
+    return 0;
+}
+
+int SpineAllocator::sizeClass(size_t size) const
+{
+    for (int i = 0; i < kPoolCount; i++) {
+        if (size <= kPoolBlockSizes[i]) return i;
+    }
+    return -1;
+}
+
+SpineAllocator::BlockHeader* SpineAllocator::allocateBlock(size_t size, uint16_t site)
+{
+    size_t total = size + kAlignment;
+    BlockHeader *header = nullptr;
+    uint8_t kind = HeapBlock;
+    int poolIndex = -1;
+
+    if (currentArena) {
+        header = reinterpret_cast<BlockHeader*>(currentArena->allocate(total));
+        kind = ArenaBlock;
+    } else if ((poolIndex = sizeClass(total)) >= 0) {
+        Pool &pool = pools[poolIndex];
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.freeList) {
+            header = static_cast<BlockHeader*>(pool.freeList);
+            pool.freeList = *static_cast<void**>(pool.freeList);
+        } else {
+            if (pool.blockSize > static_cast<size_t>(pool.end - pool.cursor)) {
+                char *chunk = static_cast<char*>(std::malloc(kPoolChunkSize));
+                if (!chunk) return nullptr;
+                pool.chunks.push_back(chunk);
+                pool.cursor = chunk;
+                pool.end = chunk + kPoolChunkSize;
+            }
+            header = reinterpret_cast<BlockHeader*>(pool.cursor);
+            pool.cursor += pool.blockSize;
+        }
+        kind = PoolBlock;
+    } else {
+        header = static_cast<BlockHeader*>(std::malloc(total));
+    }
+    if (!header) return nullptr;
+
+    header->size = size;
+    header->site = site;
+    header->kind = kind;
+    header->sizeClass = static_cast<uint8_t>(poolIndex < 0 ? 0 : poolIndex);
+    track(header, 1);
+    return header;
+}
+
+void SpineAllocator::releaseBlock(BlockHeader *header)
+{
+    track(header, -1);
+    switch (header->kind) {
+        case HeapBlock:
+            std::free(header);
+            break;
+        case PoolBlock: {
+            Pool &pool = pools[header->sizeClass];
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            *reinterpret_cast<void**>(header) = pool.freeList;
+            pool.freeList = header;
+            break;
+        }
+        default:
+            // Arena内存随Arena整体释放
+            break;
+    }
+}
+
+void SpineAllocator::track(BlockHeader *header, int64_t sign)
+{
+    int64_t bytes = sign * static_cast<int64_t>(header->size);
+    Site &site = sites[header->site];
+    site.liveBytes.fetch_add(bytes, std::memory_order_relaxed);
+    site.liveBlocks.fetch_add(sign, std::memory_order_relaxed);
+    if (sign > 0) site.totalBlocks.fetch_add(1, std::memory_order_relaxed);
+    kindBytes[header->kind].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void *SpineAllocator::_alloc(size_t size, const char *file, int line)
+{
+    if (size == 0) return nullptr;
+    BlockHeader *header = allocateBlock(size, siteIndex(file, line));
+    return header ? reinterpret_cast<char*>(header) + kAlignment : nullptr;
+}
+
+void *SpineAllocator::_calloc(size_t size, const char *file, int line)
+{
+    void *ptr = _alloc(size, file, line);
+    if (ptr) std::memset(ptr, 0, size);
+    return ptr;
+}
+
+void *SpineAllocator::_realloc(void *ptr, size_t size, const char *file, int line)
+{
+    // 与默认扩展一致：大小为0时返回空且不释放原内存
+    if (size == 0) return nullptr;
+    if (!ptr) return _alloc(size, file, line);
+
+    BlockHeader *header = reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - kAlignment);
+    uint16_t site = siteIndex(file, line);
+    size_t total = size + kAlignment;
+
+    // 能原地满足时只更新统计
+    bool inPlace = false;
+    if (header->kind == PoolBlock) {
+        inPlace = total <= pools[header->sizeClass].blockSize;
+    } else if (header->kind == ArenaBlock) {
+        inPlace = currentArena && currentArena->extend(reinterpret_cast<char*>(header), header->size + kAlignment, total);
+    } else if (!currentArena && sizeClass(total) < 0) {
+        track(header, -1);
+        BlockHeader *moved = static_cast<BlockHeader*>(std::realloc(header, total));
+        if (!moved) {
+            track(header, 1);
+            return nullptr;
+        }
+        moved->size = size;
+        moved->site = site;
+        track(moved, 1);
+        return reinterpret_cast<char*>(moved) + kAlignment;
+    }
+
+    if (inPlace) {
+        track(header, -1);
+        header->size = size;
+        header->site = site;
+        track(header, 1);
+        return ptr;
+    }
+
+    BlockHeader *moved = allocateBlock(size, site);
+    if (!moved) return nullptr;
+    std::memcpy(reinterpret_cast<char*>(moved) + kAlignment, ptr, std::min(size, header->size));
+    releaseBlock(header);
+    return reinterpret_cast<char*>(moved) + kAlignment;
+}
+
+void SpineAllocator::_free(void *mem, const char *file, int line)
+{
+    SP_UNUSED(file);
+    SP_UNUSED(line);
+
+    if (!mem) return;
+    releaseBlock(reinterpret_cast<BlockHeader*>(static_cast<char*>(mem) - kAlignment));
+}
+
+std::vector<SpineAllocator::SiteStatistics> SpineAllocator::statistics() const
+{
+    QHash<QString, SiteStatistics> merged;
+    for (int i = 0; i < kSiteCount; i++) {
+        const Site &site = sites[i];
+        if (!site.used.load(std::memory_order_acquire)) continue;
+        int64_t totalBlocks = site.totalBlocks.load(std::memory_order_relaxed);
+        if (totalBlocks == 0) continue;
+
+        QString name = siteName(site.file, site.line);
+        SiteStatistics &entry = merged[name];
+        entry.site = name;
+        entry.liveBytes += site.liveBytes.load(std::memory_order_relaxed);
+        entry.liveBlocks += site.liveBlocks.load(std::memory_order_relaxed);
+        entry.totalBlocks += totalBlocks;
+    }
+
+    std::vector<SiteStatistics> result;
+    result.reserve(merged.size());
+    for (const SiteStatistics &entry : merged) {
+        result.push_back(entry);
+    }
+    std::sort(result.begin(), result.end(), [](const SiteStatistics &a, const SiteStatistics &b) {
+        return a.liveBytes != b.liveBytes ? a.liveBytes > b.liveBytes : a.site < b.site;
+    });
+    return result;
+}
+
+void SpineAllocator::dumpStatistics(int maxSites) const
+{
+    qDebug() << "Spine memory live bytes: heap" << kindBytes[HeapBlock].load(std::memory_order_relaxed)
+             << "pool" << kindBytes[PoolBlock].load(std::memory_order_relaxed)
+             << "arena" << kindBytes[ArenaBlock].load(std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(arenaMutex);
+        for (const Arena *arena : arenas) {
+            qDebug() << "  arena" << arena->name() << "used" << arena->usedBytes()
+                     << "reserved" << arena->reservedBytes();
+        }
+    }
+
+    std::vector<SiteStatistics> sites = statistics();
+    int count = std::min(maxSites, static_cast<int>(sites.size()));
+    for (int i = 0; i < count; i++) {
+        const SiteStatistics &entry = sites[i];
+        qDebug() << "  " << entry.site << "live" << entry.liveBytes << "bytes in" << entry.liveBlocks
+                 << "blocks," << entry.totalBlocks << "allocations";
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef SPINEALLOCATOR_H
+#define SPINEALLOCATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <QString>
+#include <spine/Extension.h>
+
+// spine-cpp的内存分配扩展
+// 每块内存前有16字节头，记录大小、来源和分配位置（file:line），释放时据此归还并更新统计：
+// - 骨骼数据加载期间（ArenaScope生效的线程上）从该资源的Arena顺序分配，释放为空操作，Arena销毁时整体归还
+// - 其余小块按大小分级从固定块池分配，大块直接malloc
+// 各分配位置的存活字节数/块数可随时用dumpStatistics输出。所有接口线程安全，可配合SpineUpdateScheduler并行更新
+class SpineAllocator : public spine::DefaultSpineExtension
+{
+public:
+    // 一份骨骼数据的加载期内存，必须比分配在其中的对象（SkeletonData）活得久
+    class Arena
+    {
+    public:
+        explicit Arena(const QString &name);
+        ~Arena();
+        Arena(const Arena &) = delete;
+        Arena& operator=(const Arena &) = delete;
+
+        const QString& name() const { return label; }
+        size_t usedBytes() const { return used.load(std::memory_order_relaxed); }
+        size_t reservedBytes() const { return reserved.load(std::memory_order_relaxed); }
+
+    private:
+        char* allocate(size_t size);
+        bool extend(char *block, size_t oldSize, size_t newSize);
+
+        QString label;
+        std::vector<char*> chunks;
+        char *cursor = nullptr;
+        char *end = nullptr;
+        char *last = nullptr;      // 最近一次分配的块，可原地扩展
+        std::atomic<size_t> used;
+        std::atomic<size_t> reserved;
+
+        friend class SpineAllocator;
+    };
+
+    // 作用域内当前线程的spine分配都进入arena
+    class ArenaScope
+    {
+    public:
+        explicit ArenaScope(Arena *arena);
+        ~ArenaScope();
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope& operator=(const ArenaScope &) = delete;
+
+    private:
+        Arena *previous;
+    };
+
+    struct SiteStatistics {
+        QString site;           // 文件名:行号
+        int64_t liveBytes = 0;
+        int64_t liveBlocks = 0;
+        int64_t totalBlocks = 0;    // 累计分配次数
+    };
+
+    SpineAllocator();
+    ~SpineAllocator() override;
+
+    // 当前作为spine扩展的实例，未启用时为空
+    static SpineAllocator* instance();
+
+    // 按存活字节数降序，同一文件名:行号合并
+    std::vector<SiteStatistics> statistics() const;
+    void dumpStatistics(int maxSites = 40) const;
+
+protected:
+    void *_alloc(size_t size, const char *file, int line) override;
+    void *_calloc(size_t size, const char *file, int line) override;
+    void *_realloc(void *ptr, size_t size, const char *file, int line) override;
+    void _free(void *mem, const char *file, int line) override;
+
+private:
+    enum BlockKind : uint8_t { HeapBlock, PoolBlock, ArenaBlock };
+
+    struct BlockHeader {
+        size_t size;            // 请求的字节数，不含头
+        uint16_t site;
+        uint8_t kind;
+        uint8_t sizeClass;
+    };
+
+    struct Site {
+        std::atomic<bool> used{false};
+        const char *file = nullptr;
+        int line = 0;
+        std::atomic<int64_t> liveBytes{0};
+        std::atomic<int64_t> liveBlocks{0};
+        std::atomic<int64_t> totalBlocks{0};
+    };
+
+    // 一个大小级别的固定块池，空闲块串成单链表
+    struct Pool {
+        std::mutex mutex;
+        size_t blockSize = 0;
+        void *freeList = nullptr;
+        char *cursor = nullptr;
+        char *end = nullptr;
+        std::vector<char*> chunks;
+    };
+
+    static const int kSiteCount = 4096;
+    static const int kPoolCount = 12;
+
+    uint16_t siteIndex(const char *file, int line);
+    int sizeClass(size_t size) const;
+    BlockHeader* allocateBlock(size_t size, uint16_t site);
+    void releaseBlock(BlockHeader *header);
+    void track(BlockHeader *header, int64_t sign);
+
+    Site sites[kSiteCount];
+    std::mutex siteMutex;
+    Pool pools[kPoolCount];
+    std::atomic<int64_t> kindBytes[3];
+
+    mutable std::mutex arenaMutex;
+    std::vector<Arena*> arenas;
+
+    static SpineAllocator *current;
+};
+
+#endif // SPINEALLOCATOR_H
@@ -0,0 +1,197 @@
+#include "SpineBakedAnimation.h"
+#include "SpineRenderer.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+std::shared_ptr<SpineBakedAnimation> SpineBakedAnimation::bake(spine::SkeletonData *data, const QString &animationName,
+                                                               float sampleRate, Precision precision)
+{
+    if (!data || sampleRate <= 0.0f) return nullptr;
+
+    QByteArray name = animationName.toUtf8();
+    spine::Animation *animation = data->findAnimation(spine::String(name.constData()));
+    if (!animation) {
+        qWarning() << "Cannot bake missing Spine animation:" << animationName;
+        return nullptr;
+    }
+
+    std::shared_ptr<SpineBakedAnimation> baked(new SpineBakedAnimation());
+    baked->data = data;
+    baked->animationDuration = animation->getDuration();
+    baked->rate = sampleRate;
+    // 前面各帧取在k/rate，最后一帧取在动画结尾，循环时最后一帧与第一帧之间也能插值
+    baked->frames = static_cast<int>(std::ceil(baked->animationDuration * sampleRate)) + 1;
+    baked->lastFrameTime = baked->animationDuration;
+    baked->bones = static_cast<int>(data->getBones().size());
+    baked->slots = static_cast<int>(data->getSlots().size());
+    baked->storedPrecision = precision;
+    baked->poses.assign(static_cast<size_t>(baked->frames) * baked->bones * kFloatStride, 0.0f);
+    baked->attachments.resize(static_cast<size_t>(baked->frames) * baked->slots);
+
+    spine::Skeleton skeleton(data);
+    float previousTime = 0.0f;
+    for (int frame = 0; frame < baked->frames; frame++) {
+        float time = baked->frameTime(frame);
+        skeleton.setToSetupPose();
+        animation->apply(skeleton, time, time, false, nullptr, 1.0f, spine::MixBlend_Setup, spine::MixDirection_In);
+        // 物理约束按实际采样间隔连续模拟
+        if (frame == 0) {
+            skeleton.updateWorldTransform(spine::Physics_Reset);
+        } else {
+            skeleton.update(time - previousTime);
+            skeleton.updateWorldTransform(spine::Physics_Update);
+        }
+        previousTime = time;
+
+        float *out = &baked->poses[static_cast<size_t>(frame) * baked->bones * kFloatStride];
+        spine::Vector<spine::Bone*> &skeletonBones = skeleton.getBones();
+        for (int i = 0; i < baked->bones; i++, out += kFloatStride) {
+            spine::Bone &bone = *skeletonBones[i];
+            out[0] = bone.getA();
+            out[1] = bone.getB();
+            out[2] = bone.getC();
+            out[3] = bone.getD();
+            out[4] = bone.getWorldX();
+            out[5] = bone.getWorldY();
+        }
+
+        spine::Vector<spine::Slot*> &skeletonSlots = skeleton.getSlots();
+        for (int i = 0; i < baked->slots; i++) {
+            baked->attachments[static_cast<size_t>(frame) * baked->slots + i] = skeletonSlots[i]->getAttachment();
+        }
+    }
+
+    if (precision == Precision::Quantized16) {
+        baked->quantize();
+    }
+    return baked;
+}
+
+void SpineBakedAnimation::quantize()
+{
+    // 每根骨骼的每个分量在所有帧上的取值范围映射到[0, 65535]
+    ranges.assign(static_cast<size_t>(bones) * kQuantizedStride * 2, 0.0f);
+    quantizedPoses.resize(static_cast<size_t>(frames) * bones * kQuantizedStride);
+
+    for (int bone = 0; bone < bones; bone++) {
+        for (int component = 0; component < kQuantizedStride; component++) {
+            float low = poses[static_cast<size_t>(bone) * kFloatStride + component];
+            float high = low;
+            for (int frame = 1; frame < frames; frame++) {
+                float value = poses[(static_cast<size_t>(frame) * bones + bone) * kFloatStride + component];
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+
+            float scale = high > low ? (high - low) / 65535.0f : 0.0f;
+            float *range = &ranges[(static_cast<size_t>(bone) * kQuantizedStride + component) * 2];
+            range[0] = low;
+            range[1] = scale;
+
+            for (int frame = 0; frame < frames; frame++) {
+                float value = poses[(static_cast<size_t>(frame) * bones + bone) * kFloatStride + component];
+                int level = scale > 0.0f ? static_cast<int>(std::lround((value - low) / scale)) : 0;
+                level = std::max(0, std::min(65535, level));
+                // 按有符号存储，读取时加回32768
+                quantizedPoses[(static_cast<size_t>(frame) * bones + bone) * kQuantizedStride + component] =
+                    static_cast<int16_t>(level - 32768);
+            }
+        }
+    }
+
+    poses.clear();
+    poses.shrink_to_fit();
+}
+
+size_t SpineBakedAnimation::memoryBytes() const
+{
+    return poses.size() * sizeof(float) + quantizedPoses.size() * sizeof(int16_t) +
+           ranges.size() * sizeof(float) + attachments.size() * sizeof(spine::Attachment*) + sizeof(*this);
+}
+
+void SpineBakedAnimation::samplePose(int frame, float *out) const
+{
+    if (!poses.empty()) {
+        const float *pose = &poses[static_cast<size_t>(frame) * bones * kFloatStride];
+        for (int bone = 0; bone < bones; bone++, pose += kFloatStride, out += kQuantizedStride) {
+            std::copy(pose, pose + kQuantizedStride, out);
+        }
+        return;
+    }
+
+    const int16_t *pose = &quantizedPoses[static_cast<size_t>(frame) * bones * kQuantizedStride];
+    const float *range = ranges.data();
+    for (int i = 0; i < bones * kQuantizedStride; i++, range += 2) {
+        out[i] = range[0] + (pose[i] + 32768) * range[1];
+    }
+}
+
+void SpineBakedAnimation::apply(spine::Skeleton &skeleton, float time, bool loop) const
+{
+    if (skeleton.getData() != data || frames == 0) return;
+
+    if (loop && animationDuration > 0.0f) {
+        time = std::fmod(time, animationDuration);
+        if (time < 0.0f) time += animationDuration;
+    }
+    time = std::max(0.0f, std::min(time, lastFrameTime));
+
+    // 按两帧的实际采样时间插值，最后一段的间隔可能短于1/rate
+    int frame = std::min(static_cast<int>(time * rate), frames - 1);
+    int next = std::min(frame + 1, frames - 1);
+    float interval = frameTime(next) - frameTime(frame);
+    float alpha = interval > 0.0f ? std::max(0.0f, std::min((time - frameTime(frame)) / interval, 1.0f)) : 0.0f;
+
+    // 两帧先解出到线程局部的临时数组（量化表需要解码），再逐骨骼插值写入
+    thread_local std::vector<float> scratch;
+    scratch.resize(static_cast<size_t>(bones) * kQuantizedStride * 2);
+    float *from = scratch.data();
+    float *to = from + static_cast<size_t>(bones) * kQuantizedStride;
+    samplePose(frame, from);
+    samplePose(next, to);
+
+    spine::Vector<spine::Bone*> &skeletonBones = skeleton.getBones();
+    for (int i = 0; i < bones; i++, from += kQuantizedStride, to += kQuantizedStride) {
+        spine::Bone &bone = *skeletonBones[i];
+        bone.setA(from[0] + (to[0] - from[0]) * alpha);
+        bone.setB(from[1] + (to[1] - from[1]) * alpha);
+        bone.setC(from[2] + (to[2] - from[2]) * alpha);
+        bone.setD(from[3] + (to[3] - from[3]) * alpha);
+        bone.setWorldX(from[4] + (to[4] - from[4]) * alpha);
+        bone.setWorldY(from[5] + (to[5] - from[5]) * alpha);
+    }
+
+    // 附件不插值，取最近的一帧
+    int nearest = alpha < 0.5f ? frame : next;
+    spine::Attachment *const *frameAttachments = &attachments[static_cast<size_t>(nearest) * slots];
+    spine::Vector<spine::Slot*> &skeletonSlots = skeleton.getSlots();
+    for (int i = 0; i < slots; i++) {
+        if (skeletonSlots[i]->getAttachment() != frameAttachments[i]) {
+            skeletonSlots[i]->setAttachment(frameAttachments[i]);
+        }
+    }
+}
+
+SpineBakedActor::SpineBakedActor(std::shared_ptr<SpineAsset> asset, std::shared_ptr<SpineBakedAnimation> animation,
+                                 float startTime)
+    : asset(asset)
+    , animation(animation)
+    , skeletonInstance(new spine::Skeleton(asset->skeletonData()))
+    , time(startTime)
+    , speed(1.0f)
+{
+    skeletonInstance->setToSetupPose();
+    animation->apply(*skeletonInstance, time);
+}
+
+SpineBakedActor::~SpineBakedActor()
+{
+    delete skeletonInstance;
+}
+
+void SpineBakedActor::advance(float deltaTime)
+{
+    time += deltaTime * speed;
+    animation->apply(*skeletonInstance, time);
+}
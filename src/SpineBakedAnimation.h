@@ -0,0 +1,94 @@
+#ifndef SPINEBAKEDANIMATION_H
+#define SPINEBAKEDANIMATION_H
+
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <spine/spine.h>
+
+class SpineAsset;
+
+// 以固定采样率烘焙的动画姿势表，用于大量只循环播放少数动画的背景角色
+// 烘焙时逐帧执行Animation::apply + updateWorldTransform，记录每根骨骼的世界仿射变换和每个插槽的附件；
+// 播放时只按时间查表并在相邻两帧之间线性插值，不经过AnimationState、时间轴、混合和约束
+// 颜色、形变和绘制顺序不烘焙，保持骨骼的初始姿势
+class SpineBakedAnimation
+{
+public:
+    enum class Precision {
+        Float,          // 每根骨骼8个float，可直接作为纹理上传
+        Quantized16     // 每根骨骼6个int16，按骨骼分量的取值范围量化
+    };
+
+    // 失败时返回nullptr（找不到动画或参数无效）
+    static std::shared_ptr<SpineBakedAnimation> bake(spine::SkeletonData *data, const QString &animationName,
+                                                     float sampleRate = 30.0f,
+                                                     Precision precision = Precision::Float);
+
+    // 把time处的姿势写入skeleton（骨骼世界变换和插槽附件），skeleton必须来自烘焙用的骨骼数据
+    void apply(spine::Skeleton &skeleton, float time, bool loop = true) const;
+
+    float duration() const { return animationDuration; }
+    float sampleRate() const { return rate; }
+    int frameCount() const { return frames; }
+    int boneCount() const { return bones; }
+    Precision precision() const { return storedPrecision; }
+    size_t memoryBytes() const;
+
+    // Float精度的原始表：每帧一行，每根骨骼两个RGBA texel：(a, b, c, d)、(worldX, worldY, 0, 0)
+    // 与SpineRenderer骨骼UBO的布局一致，可作为GL_RGBA32F纹理上传；量化时返回nullptr
+    const float *textureData() const { return poses.empty() ? nullptr : poses.data(); }
+    int textureWidth() const { return bones * 2; }
+    int textureHeight() const { return frames; }
+
+private:
+    static constexpr int kFloatStride = 8;
+    static constexpr int kQuantizedStride = 6;
+
+    SpineBakedAnimation() = default;
+
+    float frameTime(int frame) const { return frame == frames - 1 ? lastFrameTime : frame / rate; }
+
+    void quantize();
+    void samplePose(int frame, float *out) const;
+
+    spine::SkeletonData *data = nullptr;
+    float animationDuration = 0.0f;
+    float rate = 0.0f;
+    float lastFrameTime = 0.0f;     // 最后一帧取在动画结尾，与前一帧的间隔可能小于1/rate
+    int frames = 0;
+    int bones = 0;
+    int slots = 0;
+    Precision storedPrecision = Precision::Float;
+
+    std::vector<float> poses;                       // Float：frames * bones * 8
+    std::vector<int16_t> quantizedPoses;            // Quantized16：frames * bones * 6
+    std::vector<float> ranges;                      // Quantized16：每根骨骼6个分量的(最小值, 步长)
+    std::vector<spine::Attachment*> attachments;    // frames * slots，取最近的帧
+};
+
+// 播放烘焙动画的骨骼实例，只有一个播放时间
+class SpineBakedActor
+{
+public:
+    SpineBakedActor(std::shared_ptr<SpineAsset> asset, std::shared_ptr<SpineBakedAnimation> animation,
+                    float startTime = 0.0f);
+    ~SpineBakedActor();
+    SpineBakedActor(const SpineBakedActor &) = delete;
+    SpineBakedActor& operator=(const SpineBakedActor &) = delete;
+
+    void advance(float deltaTime);
+    void setSpeed(float value) { speed = value; }
+
+    spine::Skeleton& skeleton() { return *skeletonInstance; }
+
+private:
+    std::shared_ptr<SpineAsset> asset;
+    std::shared_ptr<SpineBakedAnimation> animation;
+    spine::Skeleton *skeletonInstance;
+    float time;
+    float speed;
+};
+
+#endif // SPINEBAKEDANIMATION_H
@@ -0,0 +1,1014 @@
+#include "SpineRenderer.h"
+#include "BaseRenderer.h"
+#include "SpineAllocator.h"
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <spine/Version.h>
+#include <algorithm>
+#include <cstddef>
+
+// spine-cpp要求宿主提供默认扩展（内存分配、文件读取）；分配走带统计的Arena/固定块池
+spine::SpineExtension *spine::getDefaultExtension()
+{
+    return new SpineAllocator();
+}
+
+namespace {
+const char *const kSpineVertexShader = R"(#version 330 core
+    layout(location = 0) in vec2 position;
+    layout(location = 1) in vec2 texCoord;
+    layout(location = 2) in vec4 color;
+    layout(location = 3) in vec4 darkColor;
+    uniform mat4 projection;
+    uniform mat4 view;
+    out vec2 uv;
+    out vec4 light;
+    out vec4 dark;
+    void main() {
+        uv = texCoord;
+        // 颜色按0xAARRGGBB打包，小端内存顺序为BGRA
+        light = color.zyxw;
+        dark = darkColor.zyxw;
+        gl_Position = projection * view * vec4(position, 0.0, 1.0);
+    }
+)";
+
+// 双色染色，输出预乘alpha
+const char *const kSpineFragmentShader = R"(#version 330 core
+    in vec2 uv;
+    in vec4 light;
+    in vec4 dark;
+    uniform sampler2D textureSampler;
+    uniform int premultiplied;
+    out vec4 fragColor;
+    void main() {
+        vec4 texColor = texture(textureSampler, uv);
+        if (premultiplied == 0) texColor.rgb *= texColor.a;
+        vec3 lightColor = light.rgb * light.a;
+        vec3 darkColor = dark.rgb * light.a;
+        fragColor.a = texColor.a * light.a;
+        fragColor.rgb = ((texColor.a - 1.0) * dark.a + 1.0 - texColor.rgb) * darkColor + texColor.rgb * lightColor;
+    }
+)";
+
+// GPU蒙皮：每个顶点最多4个骨骼影响，骨骼矩阵放在UBO里，每根骨骼两个vec4
+const char *const kSpineSkinnedVertexShader = R"(#version 330 core
+    layout(location = 0) in vec4 position01;
+    layout(location = 1) in vec4 position23;
+    layout(location = 2) in vec4 weights;
+    layout(location = 3) in vec2 texCoord;
+    layout(location = 4) in uvec4 boneIndices;
+    layout(location = 5) in vec4 deform01;
+    layout(location = 6) in vec4 deform23;
+    layout(std140) uniform SpineBones {
+        vec4 bones[512];
+    };
+    uniform mat4 projection;
+    uniform mat4 view;
+    uniform mat4 model;
+    uniform vec4 lightColor;
+    uniform vec4 darkColor;
+    uniform int rigidBone;
+    out vec2 uv;
+    out vec4 light;
+    out vec4 dark;
+    vec2 skin(uint bone, vec2 local) {
+        vec4 m = bones[bone * 2u];
+        vec4 t = bones[bone * 2u + 1u];
+        return vec2(local.x * m.x + local.y * m.y + t.x, local.x * m.z + local.y * m.w + t.y);
+    }
+    void main() {
+        vec4 p01 = position01 + deform01;
+        vec4 p23 = position23 + deform23;
+        vec2 world;
+        if (rigidBone >= 0) {
+            world = skin(uint(rigidBone), p01.xy);
+        } else {
+            world = skin(boneIndices.x, p01.xy) * weights.x + skin(boneIndices.y, p01.zw) * weights.y +
+                    skin(boneIndices.z, p23.xy) * weights.z + skin(boneIndices.w, p23.zw) * weights.w;
+        }
+        uv = texCoord;
+        light = lightColor;
+        dark = darkColor;
+        gl_Position = projection * view * model * vec4(world, 0.0, 1.0);
+    }
+)";
+
+const unsigned short kQuadIndices[6] = {0, 1, 2, 2, 3, 0};
+
+// 与SkeletonRenderer相同的颜色规则，打包为0xAARRGGBB
+void packColors(spine::Skeleton &skeleton, spine::Slot &slot, const spine::Color &attachmentColor,
+                uint32_t &color, uint32_t &darkColor)
+{
+    const spine::Color &skeletonColor = skeleton.getColor();
+    const spine::Color &slotColor = slot.getColor();
+    uint8_t r = static_cast<uint8_t>(skeletonColor.r * slotColor.r * attachmentColor.r * 255);
+    uint8_t g = static_cast<uint8_t>(skeletonColor.g * slotColor.g * attachmentColor.g * 255);
+    uint8_t b = static_cast<uint8_t>(skeletonColor.b * slotColor.b * attachmentColor.b * 255);
+    uint8_t a = static_cast<uint8_t>(skeletonColor.a * slotColor.a * attachmentColor.a * 255);
+    color = (a << 24) | (r << 16) | (g << 8) | b;
+
+    darkColor = 0xff000000;
+    if (slot.hasDarkColor()) {
+        const spine::Color &dark = slot.getDarkColor();
+        darkColor |= (static_cast<uint8_t>(dark.r * 255) << 16) | (static_cast<uint8_t>(dark.g * 255) << 8) |
+                     static_cast<uint8_t>(dark.b * 255);
+    }
+}
+
+QVector4D unpackColor(uint32_t color)
+{
+    return QVector4D(((color >> 16) & 0xff) / 255.0f, ((color >> 8) & 0xff) / 255.0f,
+                     (color & 0xff) / 255.0f, (color >> 24) / 255.0f);
+}
+
+void *attributeOffset(size_t offset)
+{
+    return reinterpret_cast<void*>(static_cast<quintptr>(offset));
+}
+
+GLenum toGLFilter(spine::TextureFilter filter)
+{
+    // 不生成mipmap，mipmap过滤退化为线性
+    return filter == spine::TextureFilter_Nearest ? GL_NEAREST : GL_LINEAR;
+}
+
+GLenum toGLWrap(spine::TextureWrap wrap)
+{
+    switch (wrap) {
+        case spine::TextureWrap_Repeat: return GL_REPEAT;
+        case spine::TextureWrap_MirroredRepeat: return GL_MIRRORED_REPEAT;
+        default: return GL_CLAMP_TO_EDGE;
+    }
+}
+
+spine::String toSpineString(const QString &text)
+{
+    QByteArray utf8 = text.toUtf8();
+    return spine::String(utf8.constData());
+}
+
+// 二进制缓存格式版本，转换逻辑变化时递增以作废旧缓存
+const int kSpineCacheVersion = 1;
+
+// JSON骨骼对应的二进制缓存路径，按文件内容哈希命名，内容变化即自动失效
+QString skeletonCachePath(const QString &jsonPath)
+{
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray(SPINE_VERSION_STRING));
+    hash.addData(QByteArray::number(kSpineCacheVersion));
+    if (!hash.addData(&file)) return QString();
+
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty()) return QString();
+    return dir + "/spine/" + QFileInfo(jsonPath).completeBaseName() + "." +
+           QString::fromLatin1(hash.result().toHex()) + ".skel";
+}
+
+// 以1倍缩放读取JSON并写成二进制缓存，缩放在读取缓存时再应用
+bool convertSkeletonToBinary(spine::Atlas *atlas, const QString &jsonPath, const QString &cachePath)
+{
+    spine::SkeletonJson json(atlas);
+    spine::SkeletonData *data = json.readSkeletonDataFile(toSpineString(jsonPath));
+    if (!data) {
+        qWarning() << "Failed to load Spine skeleton:" << jsonPath << json.getError().buffer();
+        return false;
+    }
+
+    spine::SkeletonBinaryWriter writer;
+    spine::Vector<unsigned char> bytes;
+    bool written = writer.writeSkeletonData(*data, bytes);
+    delete data;
+    if (!written) {
+        qWarning() << "Failed to convert Spine skeleton:" << jsonPath << writer.getError().buffer();
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(reinterpret_cast<const char*>(bytes.buffer()), qint64(bytes.size())) != qint64(bytes.size()) ||
+        !file.commit()) {
+        qWarning() << "Failed to write Spine skeleton cache:" << cachePath << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// 存活的渲染器，骨骼数据释放时逐个清除其GPU蒙皮缓存
+std::vector<SpineRenderer*> &liveRenderers()
+{
+    static std::vector<SpineRenderer*> renderers;
+    return renderers;
+}
+}
+
+SpineTextureLoader::SpineTextureLoader(BaseRenderer *renderer)
+    : renderer(renderer)
+{
+}
+
+void SpineTextureLoader::load(spine::AtlasPage &page, const spine::String &path)
+{
+    QImage image(QString::fromUtf8(path.buffer()));
+    if (image.isNull()) {
+        qWarning() << "Failed to load Spine atlas page:" << path.buffer();
+        return;
+    }
+
+    SpineTexture *texture = new SpineTexture();
+    texture->image = image.convertToFormat(QImage::Format_RGBA8888);
+    texture->minFilter = toGLFilter(page.minFilter);
+    texture->magFilter = toGLFilter(page.magFilter);
+    texture->wrapS = toGLWrap(page.uWrap);
+    texture->wrapT = toGLWrap(page.vWrap);
+    texture->premultiplied = page.pma;
+
+    page.texture = texture;
+    page.width = image.width();
+    page.height = image.height();
+}
+
+void SpineTextureLoader::unload(void *texture)
+{
+    SpineTexture *spineTexture = static_cast<SpineTexture*>(texture);
+    if (!spineTexture) return;
+
+    if (spineTexture->id && renderer) {
+        renderer->deleteTexture(spineTexture->id);
+    }
+    delete spineTexture;
+}
+
+SpineAsset::~SpineAsset()
+{
+    if (data) SpineRenderer::releaseSkeletonData(data);
+    delete stateData;
+    delete data;
+    delete atlas; // 通过textureLoader释放纹理
+}
+
+std::shared_ptr<SpineAsset> SpineAsset::load(BaseRenderer *renderer, const QString &atlasPath,
+                                             const QString &skeletonPath, float scale)
+{
+    std::shared_ptr<SpineAsset> asset(new SpineAsset());
+    asset->textureLoader.reset(new SpineTextureLoader(renderer));
+    asset->atlas = new spine::Atlas(toSpineString(atlasPath), asset->textureLoader.get());
+    if (asset->atlas->getPages().size() == 0) {
+        qWarning() << "Failed to load Spine atlas:" << atlasPath;
+        return nullptr;
+    }
+
+    // 按扩展名选择二进制或JSON格式；JSON首次加载时转换为二进制缓存，之后走二进制路径
+    QString binaryPath = skeletonPath;
+    if (QFileInfo(skeletonPath).suffix().compare("json", Qt::CaseInsensitive) == 0) {
+        binaryPath = skeletonCachePath(skeletonPath);
+        if (!binaryPath.isEmpty() && !QFileInfo::exists(binaryPath) &&
+            !convertSkeletonToBinary(asset->atlas, skeletonPath, binaryPath)) {
+            binaryPath.clear();
+        }
+    }
+
+    if (!binaryPath.isEmpty()) {
+        spine::SkeletonBinary binary(asset->atlas);
+        binary.setScale(scale);
+        // 动画在首次按名字查找时才解码，只用到少数动画的骨骼不必解码全部时间轴
+        binary.setLazyAnimations(true);
+        // 加载期的不可变数据集中分配在资源自己的Arena里，随资源整体释放
+        asset->arena.reset(new SpineAllocator::Arena(QFileInfo(skeletonPath).fileName()));
+        {
+            SpineAllocator::ArenaScope scope(asset->arena.get());
+            asset->data = binary.readSkeletonDataFile(toSpineString(binaryPath));
+        }
+        if (!asset->data) {
+            qWarning() << "Failed to load Spine skeleton:" << binaryPath << binary.getError().buffer();
+            asset->arena.reset();
+            if (binaryPath == skeletonPath) return nullptr;
+            // 缓存损坏时删除，本次退回直接解析JSON
+            QFile::remove(binaryPath);
+        }
+    }
+
+    if (!asset->data) {
+        spine::SkeletonJson json(asset->atlas);
+        json.setScale(scale);
+        asset->data = json.readSkeletonDataFile(toSpineString(skeletonPath));
+        if (!asset->data) {
+            qWarning() << "Failed to load Spine skeleton:" << skeletonPath << json.getError().buffer();
+            return nullptr;
+        }
+    }
+
+    asset->stateData = new spine::AnimationStateData(asset->data);
+    asset->stateData->setDefaultMix(0.2f);
+    return asset;
+}
+
+SpineActor::SpineActor(std::shared_ptr<SpineAsset> asset)
+    : asset(asset)
+    , skeletonInstance(new spine::Skeleton(asset->data))
+    , state(new spine::AnimationState(asset->stateData))
+    , recorder(pendingEvents)
+{
+    state->setListener(&recorder);
+    // 预先备好TrackEntry，战斗中频繁切换动画时不再分配
+    state->prewarmTrackEntries(8);
+    skeletonInstance->setToSetupPose();
+    skeletonInstance->updateWorldTransform(spine::Physics_Update);
+}
+
+SpineActor::~SpineActor()
+{
+    delete state;
+    delete skeletonInstance;
+}
+
+bool SpineActor::setAnimation(const QString &name, bool loop)
+{
+    if (name == currentAnimation) return true;
+
+    spine::Animation *animation = asset->data->findAnimation(toSpineString(name));
+    if (!animation) return false;
+
+    state->setAnimation(0, animation, loop);
+    currentAnimation = name;
+    return true;
+}
+
+void SpineActor::advance(float deltaTime)
+{
+    state->update(deltaTime);
+    state->apply(*skeletonInstance);
+    skeletonInstance->update(deltaTime);
+    skeletonInstance->updateWorldTransform(spine::Physics_Update);
+}
+
+void SpineActor::dispatchEvents()
+{
+    if (pendingEvents.empty()) return;
+
+    // 回调里可能再次切换动画并产生新事件，先取出当前这一批
+    std::vector<SpineEvent> events;
+    events.swap(pendingEvents);
+    if (eventHandler) {
+        for (const SpineEvent &event : events) {
+            eventHandler(event);
+        }
+    }
+    if (pendingEvents.empty()) {
+        events.clear();
+        pendingEvents.swap(events);     // 保留容量
+    }
+}
+
+void SpineActor::update(float deltaTime)
+{
+    advance(deltaTime);
+    dispatchEvents();
+}
+
+void SpineActor::EventRecorder::callback(spine::AnimationState *, spine::EventType type, spine::TrackEntry *entry,
+                                         spine::Event *event)
+{
+    events.push_back({type, entry->getTrackIndex(), entry->getAnimation(), event});
+}
+
+SpineRenderer::SpineRenderer()
+    : renderer(nullptr)
+    , frameSink(*this)
+    , vertexBuffer(QOpenGLBuffer::VertexBuffer)
+    , indexBuffer(QOpenGLBuffer::IndexBuffer)
+    , initialized(false)
+    , gpuSkinning(false)
+    , skinningAvailable(false)
+    , extra(nullptr)
+    , uniformAlignment(256)
+    , skinnedDirty(false)
+    , skinnedVertexBuffer(QOpenGLBuffer::VertexBuffer)
+    , skinnedIndexBuffer(QOpenGLBuffer::IndexBuffer)
+    , deformBuffer(QOpenGLBuffer::VertexBuffer)
+    , boneBuffer(0)
+{
+    liveRenderers().push_back(this);
+}
+
+SpineRenderer::~SpineRenderer()
+{
+    release();
+    std::vector<SpineRenderer*> &renderers = liveRenderers();
+    renderers.erase(std::remove(renderers.begin(), renderers.end(), this), renderers.end());
+}
+
+void SpineRenderer::releaseSkeletonData(const spine::SkeletonData *data)
+{
+    for (SpineRenderer *renderer : liveRenderers()) {
+        renderer->evictSkinned(data);
+    }
+}
+
+void SpineRenderer::initialize(BaseRenderer *host)
+{
+    renderer = host;
+    initializeOpenGLFunctions();
+
+    BaseRenderer::registerGlobalShader("spine", kSpineVertexShader, kSpineFragmentShader);
+
+    vao.create();
+    vao.bind();
+
+    vertexBuffer.create();
+    vertexBuffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    vertexBuffer.bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void*>(offsetof(Vertex, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void*>(offsetof(Vertex, u)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                          reinterpret_cast<void*>(offsetof(Vertex, color)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                          reinterpret_cast<void*>(offsetof(Vertex, darkColor)));
+
+    // 索引缓冲绑定记录在VAO里
+    indexBuffer.create();
+    indexBuffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    indexBuffer.bind();
+
+    vao.release();
+    vertexBuffer.release();
+
+    // GPU蒙皮的缓冲；属性指针随网格在静态VBO中的位置变化，绘制时再设置
+    extra = QOpenGLContext::currentContext()->extraFunctions();
+    skinningAvailable = BaseRenderer::registerGlobalShader("spineSkinned", kSpineSkinnedVertexShader,
+                                                           kSpineFragmentShader);
+    if (skinningAvailable) {
+        QOpenGLShaderProgram *shader = BaseRenderer::getGlobalShader("spineSkinned");
+        GLuint blockIndex = extra->glGetUniformBlockIndex(shader->programId(), "SpineBones");
+        if (blockIndex == GL_INVALID_INDEX) {
+            qWarning() << "Spine skinning shader has no bone block, GPU skinning disabled";
+            skinningAvailable = false;
+        } else {
+            extra->glUniformBlockBinding(shader->programId(), blockIndex, 0);
+        }
+    }
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) uniformAlignment = alignment;
+
+    skinnedVao.create();
+    skinnedVao.bind();
+    skinnedVertexBuffer.create();
+    skinnedVertexBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    deformBuffer.create();
+    deformBuffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    for (GLuint location = 0; location < 5; location++) {
+        glEnableVertexAttribArray(location);
+    }
+    skinnedIndexBuffer.create();
+    skinnedIndexBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    skinnedIndexBuffer.bind();
+    skinnedVao.release();
+
+    glGenBuffers(1, &boneBuffer);
+    initialized = true;
+}
+
+void SpineRenderer::release()
+{
+    if (!initialized) return;
+
+    vao.destroy();
+    vertexBuffer.destroy();
+    indexBuffer.destroy();
+
+    skinnedVao.destroy();
+    skinnedVertexBuffer.destroy();
+    skinnedIndexBuffer.destroy();
+    deformBuffer.destroy();
+    glDeleteBuffers(1, &boneBuffer);
+    boneBuffer = 0;
+
+    // 静态网格数据随缓冲一起丢弃，重新初始化后按需再建
+    skinnedMeshes.clear();
+    skinnedVertices.clear();
+    skinnedIndices.clear();
+    skinnedDirty = false;
+    clearFrame();
+    initialized = false;
+}
+
+void SpineRenderer::addBatch(SpineTexture *texture, spine::BlendMode blendMode, int firstIndex, int indexCount)
+{
+    // 与上一个动态批次纹理和混合模式相同则合并
+    if (!batches.empty() && batches.back().skinnedDraw < 0 && batches.back().texture == texture &&
+        batches.back().blendMode == blendMode) {
+        batches.back().indexCount += indexCount;
+    } else {
+        batches.push_back({texture, blendMode, firstIndex, indexCount, -1});
+    }
+}
+
+void SpineRenderer::appendVertices(const float *positions, const float *uvs, int vertexCount,
+                                   const unsigned short *triangles, int indexCount, uint32_t color,
+                                   uint32_t darkColor, SpineTexture *texture, spine::BlendMode blendMode,
+                                   const QMatrix4x4 &modelMatrix)
+{
+    const float a = modelMatrix(0, 0), b = modelMatrix(0, 1), tx = modelMatrix(0, 3);
+    const float c = modelMatrix(1, 0), d = modelMatrix(1, 1), ty = modelMatrix(1, 3);
+
+    uint32_t base = static_cast<uint32_t>(vertices.size());
+    for (int i = 0; i < vertexCount; i++) {
+        float x = positions[i * 2];
+        float y = positions[i * 2 + 1];
+        vertices.push_back({a * x + b * y + tx, c * x + d * y + ty, uvs[i * 2], uvs[i * 2 + 1], color, darkColor});
+    }
+
+    int firstIndex = static_cast<int>(indices.size());
+    for (int i = 0; i < indexCount; i++) {
+        indices.push_back(base + triangles[i]);
+    }
+    addBatch(texture, blendMode, firstIndex, indexCount);
+}
+
+void SpineRenderer::draw(spine::Skeleton &skeleton, const QMatrix4x4 &modelMatrix)
+{
+    if (gpuSkinning && skinningAvailable && drawSkinned(skeleton, modelMatrix)) return;
+
+    size_t firstVertex = vertices.size();
+    skeletonRenderer.render(skeleton, frameSink);
+
+    // 2D仿射部分，在CPU端把顶点原地变换到世界坐标，便于多个骨骼合并到同一批次
+    const float a = modelMatrix(0, 0), b = modelMatrix(0, 1), tx = modelMatrix(0, 3);
+    const float c = modelMatrix(1, 0), d = modelMatrix(1, 1), ty = modelMatrix(1, 3);
+    for (size_t i = firstVertex; i < vertices.size(); i++) {
+        Vertex &vertex = vertices[i];
+        float x = vertex.x;
+        float y = vertex.y;
+        vertex.x = a * x + b * y + tx;
+        vertex.y = c * x + d * y + ty;
+    }
+}
+
+spine::RenderVertex *SpineRenderer::FrameSink::allocateVertices(int count, uint32_t &firstVertex)
+{
+    firstVertex = static_cast<uint32_t>(owner.vertices.size());
+    owner.vertices.resize(owner.vertices.size() + count);
+    return owner.vertices.data() + firstVertex;
+}
+
+uint32_t *SpineRenderer::FrameSink::allocateIndices(int count, uint32_t &firstIndex)
+{
+    firstIndex = static_cast<uint32_t>(owner.indices.size());
+    owner.indices.resize(owner.indices.size() + count);
+    return owner.indices.data() + firstIndex;
+}
+
+void SpineRenderer::FrameSink::addBatch(const spine::RenderBatch &batch)
+{
+    owner.addBatch(static_cast<SpineTexture*>(batch.texture), batch.blendMode,
+                   static_cast<int>(batch.firstIndex), static_cast<int>(batch.numIndices));
+}
+
+bool SpineRenderer::drawSkinned(spine::Skeleton &skeleton, const QMatrix4x4 &modelMatrix)
+{
+    // 裁剪需要在世界坐标下切三角形，整副骨骼交给CPU路径
+    spine::Vector<spine::Bone*> &bones = skeleton.getBones();
+    spine::Vector<spine::Slot*> &drawOrder = skeleton.getDrawOrder();
+    if (bones.size() > static_cast<size_t>(kMaxSkinnedBones)) return false;
+    for (size_t i = 0; i < drawOrder.size(); i++) {
+        spine::Attachment *attachment = drawOrder[i]->getAttachment();
+        if (attachment && attachment->getRTTI().isExactly(spine::ClippingAttachment::rtti)) return false;
+    }
+
+    // 每副骨骼占UBO中按对齐要求对齐的一段
+    size_t boneOffset = boneData.size() * sizeof(float);
+    boneOffset = (boneOffset + uniformAlignment - 1) / uniformAlignment * uniformAlignment;
+    boneData.resize((boneOffset + kBoneBlockBytes) / sizeof(float), 0.0f);
+    float *boneOut = &boneData[boneOffset / sizeof(float)];
+    for (size_t i = 0; i < bones.size(); i++, boneOut += 8) {
+        spine::Bone &bone = *bones[i];
+        boneOut[0] = bone.getA();
+        boneOut[1] = bone.getB();
+        boneOut[2] = bone.getC();
+        boneOut[3] = bone.getD();
+        boneOut[4] = bone.getWorldX();
+        boneOut[5] = bone.getWorldY();
+    }
+
+    // 与CPU路径一样只取2D仿射部分
+    QMatrix4x4 model(modelMatrix(0, 0), modelMatrix(0, 1), 0.0f, modelMatrix(0, 3),
+                     modelMatrix(1, 0), modelMatrix(1, 1), 0.0f, modelMatrix(1, 3),
+                     0.0f, 0.0f, 1.0f, 0.0f,
+                     0.0f, 0.0f, 0.0f, 1.0f);
+
+    for (size_t i = 0; i < drawOrder.size(); i++) {
+        spine::Slot &slot = *drawOrder[i];
+        spine::Attachment *attachment = slot.getAttachment();
+        if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) continue;
+
+        uint32_t color, darkColor;
+        spine::BlendMode blendMode = slot.getData().getBlendMode();
+
+        if (attachment->getRTTI().isExactly(spine::RegionAttachment::rtti)) {
+            spine::RegionAttachment *region = static_cast<spine::RegionAttachment*>(attachment);
+            if (region->getColor().a == 0) continue;
+
+            // 区域附件只有4个顶点，CPU变换比单独一次绘制调用便宜
+            float world[8];
+            region->computeWorldVertices(slot, world, 0, 2);
+            packColors(skeleton, slot, region->getColor(), color, darkColor);
+            appendVertices(world, region->getUVs().buffer(), 4, kQuadIndices, 6, color, darkColor,
+                           static_cast<SpineTexture*>(region->getRegion()->rendererObject), blendMode, modelMatrix);
+        } else if (attachment->getRTTI().isExactly(spine::MeshAttachment::rtti)) {
+            spine::MeshAttachment *mesh = static_cast<spine::MeshAttachment*>(attachment);
+            if (mesh->getColor().a == 0) continue;
+
+            packColors(skeleton, slot, mesh->getColor(), color, darkColor);
+            const SkinnedMesh *skinned = skinnedMesh(mesh, skeleton.getData());
+            if (!skinned) {
+                int length = static_cast<int>(mesh->getWorldVerticesLength());
+                worldVertices.resize(length);
+                mesh->computeWorldVertices(slot, 0, length, worldVertices.data(), 0, 2);
+                appendVertices(worldVertices.data(), mesh->getUVs().buffer(), length >> 1,
+                               mesh->getTriangles().buffer(), static_cast<int>(mesh->getTriangles().size()),
+                               color, darkColor, static_cast<SpineTexture*>(mesh->getRegion()->rendererObject),
+                               blendMode, modelMatrix);
+                continue;
+            }
+
+            SkinnedDraw skinnedDraw;
+            skinnedDraw.mesh = skinned;
+            skinnedDraw.boneOffset = static_cast<int>(boneOffset);
+            skinnedDraw.deformOffset = appendDeform(mesh, *skinned, slot);
+            skinnedDraw.rigidBone = mesh->getBones().size() == 0 ? slot.getBone().getData().getIndex() : -1;
+            skinnedDraw.model = model;
+            skinnedDraw.light = unpackColor(color);
+            skinnedDraw.dark = unpackColor(darkColor);
+            skinnedDraws.push_back(skinnedDraw);
+
+            batches.push_back({static_cast<SpineTexture*>(mesh->getRegion()->rendererObject), blendMode,
+                               skinned->firstIndex, skinned->indexCount,
+                               static_cast<int>(skinnedDraws.size()) - 1});
+        }
+    }
+    return true;
+}
+
+const SpineRenderer::SkinnedMesh *SpineRenderer::skinnedMesh(spine::MeshAttachment *mesh,
+                                                             const spine::SkeletonData *owner)
+{
+    auto found = skinnedMeshes.find(mesh->getId());
+    if (found != skinnedMeshes.end()) {
+        if (!found->second.supported) return nullptr;
+        refreshUVs(mesh, found->second);
+        return &found->second;
+    }
+
+    SkinnedMesh &entry = skinnedMeshes[mesh->getId()];
+    entry.owner = owner;
+
+    // 序列帧每帧切换UV，没有纹理区域的网格无法绘制，都走CPU路径
+    if (mesh->getSequence() || !mesh->getRegion()) return nullptr;
+
+    spine::Vector<int> &bones = mesh->getBones();
+    spine::Vector<float> &meshVertices = mesh->getVertices();
+    spine::Vector<float> &uvs = mesh->getUVs();
+    spine::Vector<unsigned short> &triangles = mesh->getTriangles();
+    int vertexCount = static_cast<int>(mesh->getWorldVerticesLength() >> 1);
+
+    // 超过4个骨骼影响的顶点无法放进一个uvec4
+    for (size_t b = 0; b < bones.size(); b += bones[b] + 1) {
+        if (bones[b] > kMaxInfluences) return nullptr;
+    }
+
+    entry.firstVertex = static_cast<int>(skinnedVertices.size());
+    entry.vertexCount = vertexCount;
+    entry.firstIndex = static_cast<int>(skinnedIndices.size());
+    entry.indexCount = static_cast<int>(triangles.size());
+    entry.supported = true;
+    entry.region = mesh->getRegion();
+    entry.regionUVs[0] = entry.region->u;
+    entry.regionUVs[1] = entry.region->v;
+    entry.regionUVs[2] = entry.region->u2;
+    entry.regionUVs[3] = entry.region->v2;
+    entry.regionDegrees = entry.region->degrees;
+
+    for (int v = 0, b = 0, w = 0; v < vertexCount; v++) {
+        SkinnedVertex vertex = {};
+        vertex.u = uvs[v * 2];
+        vertex.v = uvs[v * 2 + 1];
+        if (bones.size() == 0) {
+            // 无权重网格的顶点是插槽骨骼下的局部坐标，骨骼在绘制时指定
+            vertex.positions[0] = meshVertices[v * 2];
+            vertex.positions[1] = meshVertices[v * 2 + 1];
+            vertex.weights[0] = 1.0f;
+        } else {
+            int count = bones[b++];
+            for (int k = 0; k < count; k++, b++, w += 3) {
+                vertex.positions[k * 2] = meshVertices[w];
+                vertex.positions[k * 2 + 1] = meshVertices[w + 1];
+                vertex.weights[k] = meshVertices[w + 2];
+                vertex.bones[k] = static_cast<uint16_t>(bones[b]);
+            }
+        }
+        skinnedVertices.push_back(vertex);
+    }
+    skinnedIndices.insert(skinnedIndices.end(), triangles.buffer(), triangles.buffer() + triangles.size());
+    skinnedDirty = true;
+    return &entry;
+}
+
+// 换了纹理区域或区域在图集中的位置变化后（setRegion/updateRegion），把网格当前的UV写回静态顶点
+void SpineRenderer::refreshUVs(spine::MeshAttachment *mesh, SkinnedMesh &entry)
+{
+    const spine::TextureRegion *region = mesh->getRegion();
+    if (region == entry.region && region->u == entry.regionUVs[0] && region->v == entry.regionUVs[1] &&
+        region->u2 == entry.regionUVs[2] && region->v2 == entry.regionUVs[3] &&
+        region->degrees == entry.regionDegrees) {
+        return;
+    }
+
+    spine::Vector<float> &uvs = mesh->getUVs();
+    SkinnedVertex *vertex = &skinnedVertices[entry.firstVertex];
+    for (int v = 0; v < entry.vertexCount; v++, vertex++) {
+        vertex->u = uvs[v * 2];
+        vertex->v = uvs[v * 2 + 1];
+    }
+    entry.region = region;
+    entry.regionUVs[0] = region->u;
+    entry.regionUVs[1] = region->v;
+    entry.regionUVs[2] = region->u2;
+    entry.regionUVs[3] = region->v2;
+    entry.regionDegrees = region->degrees;
+    skinnedDirty = true;
+}
+
+// 去掉属于data的网格，其余网格按原顺序紧凑到新的静态数组里
+void SpineRenderer::evictSkinned(const spine::SkeletonData *data)
+{
+    bool found = false;
+    for (auto it = skinnedMeshes.begin(); it != skinnedMeshes.end();) {
+        if (it->second.owner == data) {
+            it = skinnedMeshes.erase(it);
+            found = true;
+        } else {
+            ++it;
+        }
+    }
+    if (!found) return;
+
+    std::vector<SkinnedMesh*> kept;
+    for (auto &entry : skinnedMeshes) {
+        if (entry.second.supported) kept.push_back(&entry.second);
+    }
+    std::sort(kept.begin(), kept.end(), [](const SkinnedMesh *a, const SkinnedMesh *b) {
+        return a->firstVertex < b->firstVertex;
+    });
+
+    std::vector<SkinnedVertex> vertices;
+    std::vector<uint16_t> indices;
+    for (SkinnedMesh *mesh : kept) {
+        vertices.insert(vertices.end(), skinnedVertices.begin() + mesh->firstVertex,
+                        skinnedVertices.begin() + mesh->firstVertex + mesh->vertexCount);
+        indices.insert(indices.end(), skinnedIndices.begin() + mesh->firstIndex,
+                       skinnedIndices.begin() + mesh->firstIndex + mesh->indexCount);
+        mesh->firstVertex = static_cast<int>(vertices.size()) - mesh->vertexCount;
+        mesh->firstIndex = static_cast<int>(indices.size()) - mesh->indexCount;
+    }
+    skinnedVertices.swap(vertices);
+    skinnedIndices.swap(indices);
+    skinnedDirty = true;
+}
+
+int SpineRenderer::appendDeform(spine::MeshAttachment *mesh, const SkinnedMesh &skinned, spine::Slot &slot)
+{
+    spine::Vector<float> &deform = slot.getDeform();
+    if (deform.size() == 0) return -1;
+
+    // 形变按影响展开成与静态顶点相同的布局，着色器里直接相加
+    int offset = static_cast<int>(deformData.size() * sizeof(float));
+    size_t base = deformData.size();
+    deformData.resize(base + static_cast<size_t>(skinned.vertexCount) * kMaxInfluences * 2, 0.0f);
+    float *out = &deformData[base];
+
+    spine::Vector<int> &bones = mesh->getBones();
+    if (bones.size() == 0) {
+        // 无权重网格的形变是完整顶点坐标，换算成相对绑定姿态的增量
+        spine::Vector<float> &meshVertices = mesh->getVertices();
+        for (int v = 0; v < skinned.vertexCount; v++, out += kMaxInfluences * 2) {
+            out[0] = deform[v * 2] - meshVertices[v * 2];
+            out[1] = deform[v * 2 + 1] - meshVertices[v * 2 + 1];
+        }
+    } else {
+        for (int v = 0, b = 0, f = 0; v < skinned.vertexCount; v++, out += kMaxInfluences * 2) {
+            int count = bones[b];
+            b += count + 1;
+            for (int k = 0; k < count; k++, f += 2) {
+                out[k * 2] = deform[f];
+                out[k * 2 + 1] = deform[f + 1];
+            }
+        }
+    }
+    return offset;
+}
+
+void SpineRenderer::uploadSkinned()
+{
+    if (skinnedDirty) {
+        skinnedVertexBuffer.bind();
+        skinnedVertexBuffer.allocate(skinnedVertices.data(),
+                                     static_cast<int>(skinnedVertices.size() * sizeof(SkinnedVertex)));
+        skinnedVao.bind();
+        skinnedIndexBuffer.bind();
+        skinnedIndexBuffer.allocate(skinnedIndices.data(), static_cast<int>(skinnedIndices.size() * sizeof(uint16_t)));
+        skinnedVao.release();
+        skinnedDirty = false;
+    }
+
+    if (!deformData.empty()) {
+        deformBuffer.bind();
+        deformBuffer.allocate(deformData.data(), static_cast<int>(deformData.size() * sizeof(float)));
+        deformBuffer.release();
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, boneBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(boneData.size() * sizeof(float)), boneData.data(),
+                 GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void SpineRenderer::drawSkinnedBatch(const Batch &batch, QOpenGLShaderProgram *shader)
+{
+    const SkinnedDraw &draw = skinnedDraws[batch.skinnedDraw];
+    extra->glBindBufferRange(GL_UNIFORM_BUFFER, 0, boneBuffer, draw.boneOffset, kBoneBlockBytes);
+    shader->setUniformValue("model", draw.model);
+    shader->setUniformValue("lightColor", draw.light);
+    shader->setUniformValue("darkColor", draw.dark);
+    shader->setUniformValue("rigidBone", draw.rigidBone);
+
+    // 索引相对网格起点，属性指针指向网格在静态VBO中的位置
+    const size_t base = static_cast<size_t>(draw.mesh->firstVertex) * sizeof(SkinnedVertex);
+    const size_t positions = base + offsetof(SkinnedVertex, positions);
+    skinnedVertexBuffer.bind();
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), attributeOffset(positions));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex),
+                          attributeOffset(positions + 4 * sizeof(float)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex),
+                          attributeOffset(base + offsetof(SkinnedVertex, weights)));
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex),
+                          attributeOffset(base + offsetof(SkinnedVertex, u)));
+    extra->glVertexAttribIPointer(4, 4, GL_UNSIGNED_SHORT, sizeof(SkinnedVertex),
+                                  attributeOffset(base + offsetof(SkinnedVertex, bones)));
+
+    if (draw.deformOffset >= 0) {
+        const GLsizei stride = kMaxInfluences * 2 * sizeof(float);
+        deformBuffer.bind();
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, attributeOffset(draw.deformOffset));
+        glEnableVertexAttribArray(6);
+        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, attributeOffset(draw.deformOffset + 4 * sizeof(float)));
+    } else {
+        // 没有形变时用常量0
+        glDisableVertexAttribArray(5);
+        glDisableVertexAttribArray(6);
+        glVertexAttrib4f(5, 0.0f, 0.0f, 0.0f, 0.0f);
+        glVertexAttrib4f(6, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    glDrawElements(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_SHORT,
+                   attributeOffset(static_cast<size_t>(batch.firstIndex) * sizeof(uint16_t)));
+}
+
+void SpineRenderer::uploadTexture(SpineTexture *texture)
+{
+    renderer->createTextureFromImage(texture->image, texture->id, texture->minFilter, texture->magFilter);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texture->wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texture->wrapT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // 上传后不再需要CPU端副本
+    texture->image = QImage();
+}
+
+void SpineRenderer::applyBlendMode(spine::BlendMode blendMode)
+{
+    // 着色器输出预乘alpha
+    switch (blendMode) {
+        case spine::BlendMode_Additive:
+            glBlendFunc(GL_ONE, GL_ONE);
+            break;
+        case spine::BlendMode_Multiply:
+            glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case spine::BlendMode_Screen:
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_COLOR);
+            break;
+        default:
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+    }
+}
+
+void SpineRenderer::clearFrame()
+{
+    vertices.clear();
+    indices.clear();
+    batches.clear();
+    skinnedDraws.clear();
+    boneData.clear();
+    deformData.clear();
+}
+
+void SpineRenderer::flush(const QMatrix4x4 &projection, const QMatrix4x4 &view)
+{
+    QOpenGLShaderProgram *shader = BaseRenderer::getGlobalShader("spine");
+    QOpenGLShaderProgram *skinnedShader = skinnedDraws.empty() ? nullptr : BaseRenderer::getGlobalShader("spineSkinned");
+    if (!initialized || !shader || batches.empty()) {
+        clearFrame();
+        return;
+    }
+
+    // 每帧整体重新分配（孤立旧缓冲），避免与上一帧的绘制同步等待
+    if (!vertices.empty()) {
+        vertexBuffer.bind();
+        vertexBuffer.allocate(vertices.data(), static_cast<int>(vertices.size() * sizeof(Vertex)));
+        vertexBuffer.release();
+
+        vao.bind();
+        indexBuffer.bind();
+        indexBuffer.allocate(indices.data(), static_cast<int>(indices.size() * sizeof(uint32_t)));
+        vao.release();
+    }
+    if (skinnedShader) {
+        uploadSkinned();
+        skinnedShader->bind();
+        skinnedShader->setUniformValue("projection", projection);
+        skinnedShader->setUniformValue("view", view);
+        skinnedShader->setUniformValue("textureSampler", 0);
+    }
+
+    shader->bind();
+    shader->setUniformValue("projection", projection);
+    shader->setUniformValue("view", view);
+    shader->setUniformValue("textureSampler", 0);
+
+    // 同一深度的三角形按提交顺序叠加，不能做深度测试
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    glActiveTexture(GL_TEXTURE0);
+
+    // 动态批次和蒙皮批次按绘制顺序交错，只在类型变化时切换着色器和VAO
+    QOpenGLShaderProgram *current = nullptr;
+    for (const Batch &batch : batches) {
+        if (!batch.texture) continue;
+        bool skinned = batch.skinnedDraw >= 0;
+        if (skinned && !skinnedShader) continue;
+        if (!batch.texture->id) {
+            uploadTexture(batch.texture);
+        }
+
+        QOpenGLShaderProgram *wanted = skinned ? skinnedShader : shader;
+        if (current != wanted) {
+            current = wanted;
+            current->bind();
+            if (skinned) skinnedVao.bind(); else vao.bind();
+        }
+
+        glBindTexture(GL_TEXTURE_2D, batch.texture->id);
+        current->setUniformValue("premultiplied", batch.texture->premultiplied ? 1 : 0);
+        applyBlendMode(batch.blendMode);
+        if (skinned) {
+            drawSkinnedBatch(batch, current);
+        } else {
+            glDrawElements(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_INT,
+                           attributeOffset(static_cast<size_t>(batch.firstIndex) * sizeof(uint32_t)));
+        }
+    }
+
+    // 恢复BaseRenderer的默认状态
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (current) current->release();
+    vao.release();
+    skinnedVao.release();
+
+    clearFrame();
+}
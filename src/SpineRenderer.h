@@ -0,0 +1,258 @@
+#ifndef SPINERENDERER_H
+#define SPINERENDERER_H
+
+#include "SpineAllocator.h"
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+#include <QOpenGLVertexArrayObject>
+#include <QMatrix4x4>
+#include <QVector4D>
+#include <QImage>
+#include <QString>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <spine/spine.h>
+
+class BaseRenderer;
+class QOpenGLExtraFunctions;
+class QOpenGLShaderProgram;
+
+// 图集页纹理：解码后的图像先留在CPU端，首次绘制时才上传（加载时可能还没有GL上下文）
+struct SpineTexture {
+    QImage image;
+    GLuint id = 0;
+    GLenum minFilter = GL_LINEAR;
+    GLenum magFilter = GL_LINEAR;
+    GLenum wrapS = GL_CLAMP_TO_EDGE;
+    GLenum wrapT = GL_CLAMP_TO_EDGE;
+    bool premultiplied = false;
+};
+
+// 通过BaseRenderer的纹理路径上传图集页
+class SpineTextureLoader : public spine::TextureLoader
+{
+public:
+    explicit SpineTextureLoader(BaseRenderer *renderer);
+
+    void load(spine::AtlasPage &page, const spine::String &path) override;
+    void unload(void *texture) override;
+
+private:
+    BaseRenderer *renderer;
+};
+
+// 共享的骨骼资源：图集 + 骨骼数据（.json或.skel，.json按内容哈希缓存为二进制）
+class SpineAsset
+{
+public:
+    ~SpineAsset();
+
+    // scale把Spine的像素单位换算到场景单位
+    static std::shared_ptr<SpineAsset> load(BaseRenderer *renderer, const QString &atlasPath,
+                                            const QString &skeletonPath, float scale = 1.0f);
+
+    spine::SkeletonData* skeletonData() const { return data; }
+
+private:
+    SpineAsset() = default;
+
+    std::unique_ptr<SpineTextureLoader> textureLoader;
+    spine::Atlas *atlas = nullptr;
+    spine::SkeletonData *data = nullptr;
+    spine::AnimationStateData *stateData = nullptr;
+    std::unique_ptr<SpineAllocator::Arena> arena;   // 在析构函数体之后释放，晚于data
+
+    friend class SpineActor;
+};
+
+// 延迟派发的动画事件；TrackEntry在派发前可能已被回收，只保留生命周期跟随骨骼数据的部分
+struct SpineEvent {
+    spine::EventType type;
+    int trackIndex;
+    spine::Animation *animation;
+    spine::Event *event;        // 仅EventType_Event时非空
+};
+
+// 一个骨骼实例及其动画状态
+class SpineActor
+{
+public:
+    using EventHandler = std::function<void(const SpineEvent &event)>;
+
+    explicit SpineActor(std::shared_ptr<SpineAsset> asset);
+    ~SpineActor();
+
+    bool setAnimation(const QString &name, bool loop = true);
+    void setEventHandler(EventHandler handler) { eventHandler = std::move(handler); }
+
+    // 推进动画并计算世界变换，动画事件只记录不派发
+    // 只访问本实例的状态，不同实例可以在不同线程上同时调用
+    void advance(float deltaTime);
+    // 按发生顺序派发记录的事件，在主线程调用
+    void dispatchEvents();
+    void update(float deltaTime);
+
+    spine::Skeleton& skeleton() { return *skeletonInstance; }
+
+private:
+    class EventRecorder : public spine::AnimationStateListenerObject
+    {
+    public:
+        explicit EventRecorder(std::vector<SpineEvent> &events) : events(events) {}
+        void callback(spine::AnimationState *state, spine::EventType type, spine::TrackEntry *entry,
+                      spine::Event *event) override;
+
+    private:
+        std::vector<SpineEvent> &events;
+    };
+
+    std::shared_ptr<SpineAsset> asset;
+    spine::Skeleton *skeletonInstance;
+    spine::AnimationState *state;
+    QString currentAnimation;
+
+    std::vector<SpineEvent> pendingEvents;
+    EventRecorder recorder;
+    EventHandler eventHandler;
+};
+
+// SkeletonRenderer的几何数据直接写入每帧一份的动态顶点/索引数组（不经过RenderCommand的两次拷贝）
+// 用法：draw()收集若干骨骼（顶点在CPU端变换到世界坐标），flush()一次上传并按纹理/混合模式分批绘制
+//
+// GPU蒙皮模式（setGpuSkinning）：网格的绑定姿态顶点、骨骼索引、权重和UV在首次绘制时上传一次（换纹理区域后重传UV，
+// 骨骼数据释放时一并清除），之后每帧只上传骨骼世界矩阵（UBO）和有形变的网格的形变增量，顶点变换在顶点着色器里完成。
+// 区域附件、超过4个骨骼影响的顶点、序列帧网格和带裁剪的骨骼仍走CPU路径，绘制顺序不变
+class SpineRenderer : protected QOpenGLFunctions
+{
+public:
+    SpineRenderer();
+    ~SpineRenderer();
+
+    // 在宿主的initializeGL中调用
+    void initialize(BaseRenderer *renderer);
+    void release();
+
+    void setGpuSkinning(bool enabled) { gpuSkinning = enabled; }
+    bool isGpuSkinning() const { return gpuSkinning; }
+
+    void draw(spine::Skeleton &skeleton, const QMatrix4x4 &modelMatrix);
+    void flush(const QMatrix4x4 &projection, const QMatrix4x4 &view);
+
+    // 骨骼数据释放前调用，丢弃所有渲染器里属于它的GPU蒙皮网格，静态缓冲在下次绘制时重建
+    // 只改CPU端数据，不需要GL上下文；不能在draw()和flush()之间调用
+    static void releaseSkeletonData(const spine::SkeletonData *data);
+
+private:
+    static constexpr int kMaxSkinnedBones = 256;     // 与着色器里的UBO数组长度一致
+    static constexpr int kMaxInfluences = 4;
+    static constexpr int kBoneBlockBytes = kMaxSkinnedBones * 8 * static_cast<int>(sizeof(float));
+
+    // 与SkeletonRenderer的交错顶点布局一致：x, y, u, v, color(0xAARRGGBB), darkColor
+    using Vertex = spine::RenderVertex;
+
+    // SkeletonRenderer直接写入vertices/indices，批次范围交给addBatch合并
+    class FrameSink : public spine::RenderSink
+    {
+    public:
+        explicit FrameSink(SpineRenderer &owner) : owner(owner) {}
+
+        spine::RenderVertex *allocateVertices(int count, uint32_t &firstVertex) override;
+        uint32_t *allocateIndices(int count, uint32_t &firstIndex) override;
+        void addBatch(const spine::RenderBatch &batch) override;
+
+    private:
+        SpineRenderer &owner;
+    };
+
+    // GPU蒙皮的静态顶点：每个影响骨骼下的局部坐标、权重、UV、骨骼索引
+    struct SkinnedVertex {
+        float positions[kMaxInfluences * 2];
+        float weights[kMaxInfluences];
+        float u, v;
+        uint16_t bones[kMaxInfluences];
+    };
+
+    struct SkinnedMesh {
+        const spine::SkeletonData *owner = nullptr;     // 首次绘制时所属的骨骼数据
+        const spine::TextureRegion *region = nullptr;   // 写入UV时的纹理区域，区域或其UV范围变化时重写UV
+        float regionUVs[4] = {};
+        int regionDegrees = 0;
+        bool supported = false;
+        int firstVertex = 0;    // 在静态VBO中的位置
+        int vertexCount = 0;
+        int firstIndex = 0;     // 在静态IBO中的位置，索引相对网格起点
+        int indexCount = 0;
+    };
+
+    struct SkinnedDraw {
+        const SkinnedMesh *mesh;
+        int boneOffset;         // 骨骼UBO内的字节偏移
+        int deformOffset;       // 形变缓冲内的字节偏移，-1表示没有形变
+        int rigidBone;          // 无权重网格跟随插槽骨骼，-1表示按顶点权重蒙皮
+        QMatrix4x4 model;
+        QVector4D light;
+        QVector4D dark;
+    };
+
+    struct Batch {
+        SpineTexture *texture;
+        spine::BlendMode blendMode;
+        int firstIndex;
+        int indexCount;
+        int skinnedDraw;        // -1为动态顶点批次，否则为skinnedDraws的下标
+    };
+
+    void addBatch(SpineTexture *texture, spine::BlendMode blendMode, int firstIndex, int indexCount);
+    void appendVertices(const float *positions, const float *uvs, int vertexCount,
+                        const unsigned short *triangles, int indexCount, uint32_t color, uint32_t darkColor,
+                        SpineTexture *texture, spine::BlendMode blendMode, const QMatrix4x4 &modelMatrix);
+
+    bool drawSkinned(spine::Skeleton &skeleton, const QMatrix4x4 &modelMatrix);
+    const SkinnedMesh *skinnedMesh(spine::MeshAttachment *mesh, const spine::SkeletonData *owner);
+    void refreshUVs(spine::MeshAttachment *mesh, SkinnedMesh &entry);
+    void evictSkinned(const spine::SkeletonData *data);
+    int appendDeform(spine::MeshAttachment *mesh, const SkinnedMesh &skinned, spine::Slot &slot);
+    void uploadSkinned();
+    void drawSkinnedBatch(const Batch &batch, QOpenGLShaderProgram *shader);
+    void clearFrame();
+
+    void uploadTexture(SpineTexture *texture);
+    void applyBlendMode(spine::BlendMode blendMode);
+
+    BaseRenderer *renderer;
+    spine::SkeletonRenderer skeletonRenderer;
+    FrameSink frameSink;
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<Batch> batches;
+
+    QOpenGLVertexArrayObject vao;
+    QOpenGLBuffer vertexBuffer;
+    QOpenGLBuffer indexBuffer;
+    bool initialized;
+
+    // GPU蒙皮
+    bool gpuSkinning;
+    bool skinningAvailable;             // 着色器编译成功且上下文支持UBO
+    QOpenGLExtraFunctions *extra;
+    int uniformAlignment;
+    std::unordered_map<int, SkinnedMesh> skinnedMeshes;    // 键为VertexAttachment::getId()，随骨骼数据释放清除
+    std::vector<SkinnedVertex> skinnedVertices;
+    std::vector<uint16_t> skinnedIndices;
+    bool skinnedDirty;
+    std::vector<SkinnedDraw> skinnedDraws;
+    std::vector<float> boneData;        // 每根骨骼两个vec4：(a, b, c, d)、(worldX, worldY, 0, 0)
+    std::vector<float> deformData;      // 每个顶点kMaxInfluences个vec2
+    std::vector<float> worldVertices;   // 回退到CPU的网格的临时世界坐标
+
+    QOpenGLVertexArrayObject skinnedVao;
+    QOpenGLBuffer skinnedVertexBuffer;
+    QOpenGLBuffer skinnedIndexBuffer;
+    QOpenGLBuffer deformBuffer;
+    GLuint boneBuffer;
+};
+
+#endif // SPINERENDERER_H
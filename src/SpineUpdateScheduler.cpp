@@ -0,0 +1,124 @@
+#include "SpineUpdateScheduler.h"
+#include "SpineRenderer.h"
+#include <algorithm>
+
+SpineUpdateScheduler::SpineUpdateScheduler(int threadCount)
+    : batchSize(4)
+    , generation(0)
+    , stopping(false)
+    , pendingJobs(0)
+{
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+
+    for (int i = 0; i < threadCount; i++) {
+        queues.emplace_back(new Queue());
+    }
+}
+
+SpineUpdateScheduler::~SpineUpdateScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void SpineUpdateScheduler::update(const std::vector<SpineActor*> &actors, float deltaTime)
+{
+    int actorCount = static_cast<int>(actors.size());
+    if (queues.size() == 1 || actorCount <= batchSize) {
+        for (SpineActor *actor : actors) {
+            actor->advance(deltaTime);
+        }
+    } else {
+        // 工作线程在第一次需要并行时才启动，实例少的场景不占线程
+        if (workers.empty()) {
+            for (int i = 1; i < static_cast<int>(queues.size()); i++) {
+                workers.emplace_back(&SpineUpdateScheduler::workerLoop, this, i);
+            }
+        }
+
+        // 相邻实例打包在同一任务里，按轮转分到各队列
+        int jobCount = (actorCount + batchSize - 1) / batchSize;
+        pendingJobs.store(jobCount, std::memory_order_relaxed);
+        for (int job = 0; job < jobCount; job++) {
+            int first = job * batchSize;
+            Queue &queue = *queues[job % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({actors.data() + first, std::min(batchSize, actorCount - first), deltaTime});
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation++;
+        }
+        wakeCondition.notify_all();
+
+        runJobs(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this]() { return pendingJobs.load(std::memory_order_acquire) == 0; });
+    }
+
+    // 监听回调可能修改场景状态，统一回到调用线程按实例顺序派发
+    for (SpineActor *actor : actors) {
+        actor->dispatchEvents();
+    }
+}
+
+bool SpineUpdateScheduler::takeJob(int index, Job &job)
+{
+    int queueCount = static_cast<int>(queues.size());
+    for (int offset = 0; offset < queueCount; offset++) {
+        Queue &queue = *queues[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+
+        // 自己的队列从尾部取（刚放入的任务），窃取时从头部取，减少争用
+        if (offset == 0) {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+        } else {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void SpineUpdateScheduler::runJobs(int index)
+{
+    Job job;
+    while (takeJob(index, job)) {
+        for (int i = 0; i < job.count; i++) {
+            job.actors[i]->advance(job.deltaTime);
+        }
+        if (pendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // 持锁再通知，避免与调用线程的等待条件检查错过
+            std::lock_guard<std::mutex> lock(mutex);
+            doneCondition.notify_all();
+        }
+    }
+}
+
+void SpineUpdateScheduler::workerLoop(int index)
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        runJobs(index);
+    }
+}
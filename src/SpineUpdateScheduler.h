@@ -0,0 +1,61 @@
+#ifndef SPINEUPDATESCHEDULER_H
+#define SPINEUPDATESCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SpineActor;
+
+// 多个骨骼实例的并行更新
+// 实例按批次打包成任务，平均分到各线程的任务队列，线程先取自己队列尾部的任务，空了再从其他队列头部窃取；
+// 调用线程也参与执行。所有任务完成后按实例顺序串行派发动画事件，结果与逐个调用SpineActor::update一致
+class SpineUpdateScheduler
+{
+public:
+    // threadCount为参与更新的线程数（含调用线程），0表示按CPU核数；工作线程在第一次并行更新时启动
+    explicit SpineUpdateScheduler(int threadCount = 0);
+    ~SpineUpdateScheduler();
+    SpineUpdateScheduler(const SpineUpdateScheduler &) = delete;
+    SpineUpdateScheduler& operator=(const SpineUpdateScheduler &) = delete;
+
+    // 每个任务包含的实例数；实例数不超过一个批次时直接在调用线程上更新
+    void setBatchSize(int size) { batchSize = size > 0 ? size : 1; }
+    int threadCount() const { return static_cast<int>(queues.size()); }
+
+    void update(const std::vector<SpineActor*> &actors, float deltaTime);
+
+private:
+    struct Job {
+        SpineActor *const *actors;
+        int count;
+        float deltaTime;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool takeJob(int index, Job &job);
+    void runJobs(int index);
+    void workerLoop(int index);
+
+    int batchSize;
+    std::vector<std::unique_ptr<Queue>> queues;     // 下标0属于调用线程
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    uint64_t generation;
+    bool stopping;
+    std::atomic<int> pendingJobs;
+};
+
+#endif // SPINEUPDATESCHEDULER_H
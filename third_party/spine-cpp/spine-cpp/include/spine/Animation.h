@@ -47,6 +47,18 @@ namespace spine {
 
 	class AnimationState;
 
+	class Animation;
+
+	/// Decodes the timelines of animations whose loading was deferred, see SkeletonBinary::setLazyAnimations().
+	class SP_API AnimationSource : public SpineObject {
+	public:
+		virtual ~AnimationSource() {}
+
+		/// Decodes the timelines of the animation with the given index into timelines.
+		/// @return False if the data could not be decoded.
+		virtual bool loadTimelines(Animation &animation, int index, Vector<Timeline *> &timelines) = 0;
+	};
+
 	class SP_API Animation : public SpineObject {
 		friend class AnimationState;
 
@@ -99,8 +111,23 @@ namespace spine {
 	public:
 		Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
+		/// Creates an animation without timelines, they are decoded by the source on the first call to load().
+		Animation(const String &name, float duration, AnimationSource *source, int sourceIndex);
+
 		~Animation();
 
+		/// False if the animation was loaded lazily and its timelines have not been decoded yet or were released.
+		bool isLoaded();
+
+		/// Decodes the timelines of a lazily loaded animation. Called by SkeletonData::findAnimation() and
+		/// AnimationState::setAnimation()/addAnimation(). Not thread safe.
+		/// @return False if decoding failed.
+		bool load();
+
+		/// Frees the timelines of a lazily loaded animation, the next load() decodes them again. The animation must
+		/// not be used by any TrackEntry. Has no effect on animations that were not loaded lazily.
+		void release();
+
 		/// Applies all the animation's timelines to the specified skeleton.
 		/// See also Timeline::apply(Skeleton&, float, float, Vector, float, MixPose, MixDirection)
 		void apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
@@ -116,15 +143,40 @@ namespace spine {
 
 		void setDuration(float inValue);
 
+		/// Returns the index of the last frame whose time is <= target, or 0 if target is before the first frame.
+		/// Binary search, or O(1) when a SearchCursor is active and playback moved forward by at most one frame.
 		/// @param target After the first and before the last entry.
 		static int search(Vector<float> &values, float target);
 
 		static int search(Vector<float> &values, float target, int step);
+
+		/// Frame cursor hint for search(). While a SearchCursor is alive on the current thread, search() first
+		/// checks the frame it returned last time and the one after it before falling back to binary search,
+		/// so sampling during forward playback is amortized O(1). The cursor is only a hint, any value gives
+		/// the same results. AnimationState keeps one cursor per timeline per track entry.
+		class SP_API SearchCursor {
+		public:
+			explicit SearchCursor(int &frame);
+
+			~SearchCursor();
+
+		private:
+			SearchCursor(const SearchCursor &);
+
+			SearchCursor &operator=(const SearchCursor &);
+
+			int *_previous;
+		};
 	private:
+		void indexTimelines();
+
 		Vector<Timeline *> _timelines;
 		HashMap<PropertyId, bool> _timelineIds;
 		float _duration;
 		String _name;
+		AnimationSource *_source;
+		int _sourceIndex;
+		bool _loaded;
 	};
 }
 
@@ -307,6 +307,7 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry *> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		Vector<int> _timelineCursors;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
 
@@ -453,6 +454,9 @@ namespace spine {
 
 		void disposeTrackEntry(TrackEntry *entry);
 
+		/// Fills the track entry pool so that setting and queuing up to count animations does not allocate.
+		void prewarmTrackEntries(size_t count);
+
 	private:
 		static const int Subsequent = 0;
 		static const int First = 1;
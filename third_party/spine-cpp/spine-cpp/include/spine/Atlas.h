@@ -35,6 +35,7 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/HasRendererObject.h>
+#include <spine/NameIndex.h>
 #include "TextureRegion.h"
 
 namespace spine {
@@ -106,6 +107,11 @@ namespace spine {
 		Vector<float> values;
 	};
 
+	template<>
+	struct NameOf<AtlasRegion> {
+		static const String &get(AtlasRegion *region) { return region->name; }
+	};
+
 	class TextureLoader;
 
 	class SP_API Atlas : public SpineObject {
@@ -118,18 +124,27 @@ namespace spine {
 
 		void flipV();
 
-		/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-		/// should be cached rather than calling this method multiple times.
+		/// Returns the first region found with the specified name. Lookups go through a hash index built once after loading,
+		/// so attachment loaders can call this per attachment.
 		/// @return The region, or NULL.
 		AtlasRegion *findRegion(const String &name);
 
+		/// Index handle into getRegions() for the first region with the specified name.
+		/// @return -1 if not found.
+		int findRegionIndex(const String &name);
+
 		Vector<AtlasPage *> &getPages();
 
+		/// Drops the region index; it is rebuilt on the next lookup.
 		Vector<AtlasRegion *> &getRegions();
 
+		/// Call after renaming a region in place (AtlasRegion::name), which the index cannot observe.
+		void invalidateRegionIndex();
+
 	private:
 		Vector<AtlasPage *> _pages;
 		Vector<AtlasRegion *> _regions;
+		NameIndex<AtlasRegion> _regionIndex;
 		TextureLoader *_textureLoader;
 
 		void load(const char *begin, int length, const char *dir, bool createTexture);
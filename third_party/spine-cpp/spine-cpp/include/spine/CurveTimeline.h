@@ -55,13 +55,33 @@ namespace spine {
 
 		Vector<float> &getCurves();
 
+		/// When enabled (the default), timelines created afterwards precompute a lookup table per bezier that maps
+		/// time directly to the sampled segment, and use SSE2/NEON to find the segment where available. Results
+		/// are identical to the linear segment walk, which is used when disabled or for non-monotonic curves.
+		static void setBezierLookup(bool enabled);
+
+		static bool getBezierLookup();
+
 	protected:
 		static const int LINEAR = 0;
 		static const int STEPPED = 1;
 		static const int BEZIER = 2;
 		static const int BEZIER_SIZE = 18;
+		static const int BEZIER_SEGMENTS = BEZIER_SIZE / 2 + 1;
+		static const int BEZIER_LOOKUP_SIZE = 16;
+
+		/// Builds the lookup table for the bezier whose samples start at _curves[i], spanning time1 to time2.
+		void buildBezierLookup(size_t i, float time1, float time2);
+
+		/// Returns the segment of the bezier at _curves[i] that contains time: 0 before the first sample,
+		/// k between samples k - 1 and k, BEZIER_SEGMENTS - 1 after the last sample.
+		size_t getBezierSegment(float time, size_t frame, size_t i);
 
 		Vector<float> _curves; // type, x, y, ...
+		Vector<unsigned char> _bezierLookup; // BEZIER_LOOKUP_SIZE first segments per bezier, empty if disabled.
+
+	private:
+		size_t getBezierSegmentLinear(float time, size_t i);
 	};
 
 	class SP_API CurveTimeline1 : public CurveTimeline {
@@ -101,6 +121,9 @@ namespace spine {
 
 		float getCurveValue(float time);
 
+		/// Evaluates the x and y beziers of a frame together.
+		void getBezierValues(float time, size_t frame, size_t i, float &value1, float &value2);
+
 	protected:
 		static const int ENTRIES = 3;
 		static const int VALUE1 = 1;
@@ -70,6 +70,16 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		/// Maps the file read-only into memory. Returns NULL if the file can not be mapped, in which case callers should
+		/// fall back to readFile().
+		static const char *mapFile(const String &path, int *length) {
+			return getInstance()->_mapFile(path, length);
+		}
+
+		static void unmapFile(const char *data, int length) {
+			getInstance()->_unmapFile(data, length);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -88,6 +98,18 @@ namespace spine {
 
 		virtual char *_readFile(const String &path, int *length) = 0;
 
+		/// Override to support memory mapped loading. By default files are not mapped.
+		virtual const char *_mapFile(const String &path, int *length) {
+			SP_UNUSED(path);
+			SP_UNUSED(length);
+			return NULL;
+		}
+
+		virtual void _unmapFile(const char *data, int length) {
+			SP_UNUSED(data);
+			SP_UNUSED(length);
+		}
+
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
 	protected:
@@ -113,6 +135,10 @@ namespace spine {
 		virtual void _free(void *mem, const char *file, int line) override;
 
 		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual const char *_mapFile(const String &path, int *length) override;
+
+		virtual void _unmapFile(const char *data, int length) override;
 	};
 
 // This function is to be implemented by engine specific runtimes to provide
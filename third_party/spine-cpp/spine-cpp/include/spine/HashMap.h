@@ -32,6 +32,8 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
+#include <stdint.h>
+#include <new>
 
 // Required for new with line number and file name in MSVC
 #ifdef _MSC_VER
@@ -42,10 +44,55 @@
 #endif
 
 namespace spine {
+	/// Finalizer from SplitMix64, spreads sequential IDs and aligned pointers over all bits.
+	inline size_t hashMix(uint64_t value) {
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return (size_t) (value ^ (value >> 31));
+	}
+
+	/// Hash used by HashMap. Class keys provide a hash() member; integers and pointers are mixed directly.
+	template<typename K>
+	struct HashMapHash {
+		static size_t hash(const K &key) { return key.hash(); }
+	};
+
+	template<typename T>
+	struct HashMapHash<T *> {
+		static size_t hash(T *key) { return hashMix((uint64_t) (uintptr_t) key); }
+	};
+
+	template<typename T>
+	struct HashMapIntegerHash {
+		static size_t hash(T key) { return hashMix((uint64_t) key); }
+	};
+
+	template<> struct HashMapHash<char> : HashMapIntegerHash<char> {};
+	template<> struct HashMapHash<short> : HashMapIntegerHash<short> {};
+	template<> struct HashMapHash<unsigned short> : HashMapIntegerHash<unsigned short> {};
+	template<> struct HashMapHash<int> : HashMapIntegerHash<int> {};
+	template<> struct HashMapHash<unsigned int> : HashMapIntegerHash<unsigned int> {};
+	template<> struct HashMapHash<long> : HashMapIntegerHash<long> {};
+	template<> struct HashMapHash<unsigned long> : HashMapIntegerHash<unsigned long> {};
+	template<> struct HashMapHash<long long> : HashMapIntegerHash<long long> {};
+	template<> struct HashMapHash<unsigned long long> : HashMapIntegerHash<unsigned long long> {};
+
+	/// Open addressing hash map with Robin Hood probing and backward shift deletion.
+	/// Keys and values live in one contiguous slot array, there are no per entry allocations
+	/// and no tombstones. Lookups stop as soon as the probed slot is closer to its home than the key would be.
 	template<typename K, typename V>
 	class SP_API HashMap : public SpineObject {
 	private:
-		class Entry;
+		struct Slot {
+			K _key;
+			V _value;
+
+			Slot(const K &key, const V &value) : _key(key), _value(value) {}
+		};
+
+		static const size_t MinCapacity = 8;
+		// Probe distances are stored in a byte, 0 marks an empty slot.
+		static const uint8_t MaxDistance = 255;
 
 	public:
 		class SP_API Pair {
@@ -60,74 +107,64 @@ namespace spine {
 		public:
 			friend class HashMap;
 
-			explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-				_start.next = entry;
-				_entry = &_start;
-			}
-
 			Pair next() {
-				assert(_entry);
 				assert(_hasChecked);
-				_entry = _entry->next;
-				Pair pair(_entry->_key, _entry->_value);
+				assert(_index < _map->_capacity);
+				Slot &slot = _map->_slots[_index];
+				_index++;
 				_hasChecked = false;
-				return pair;
+				return Pair(slot._key, slot._value);
 			}
 
 			bool hasNext() {
 				_hasChecked = true;
-				return _entry->next;
+				while (_index < _map->_capacity && _map->_distances[_index] == 0) _index++;
+				return _index < _map->_capacity;
 			}
 
 		private:
+			explicit Entries(HashMap *map) : _map(map), _index(0), _hasChecked(false) {
+			}
+
+			HashMap *_map;
+			size_t _index;
 			bool _hasChecked;
-			Entry _start;
-			Entry *_entry;
 		};
 
 		HashMap() :
-				_head(NULL),
+				_slots(NULL),
+				_distances(NULL),
+				_capacity(0),
 				_size(0) {
 		}
 
 		~HashMap() {
 			clear();
+			if (_slots) SpineExtension::free(_slots, __FILE__, __LINE__);
+			if (_distances) SpineExtension::free(_distances, __FILE__, __LINE__);
 		}
 
 		void clear() {
-			for (Entry *entry = _head; entry != NULL;) {
-				Entry *next = entry->next;
-				delete entry;
-				entry = next;
+			for (size_t i = 0; i < _capacity; i++) {
+				if (_distances[i]) {
+					_slots[i].~Slot();
+					_distances[i] = 0;
+				}
 			}
-			_head = NULL;
 			_size = 0;
 		}
 
-		size_t size() {
+		size_t size() const {
 			return _size;
 		}
 
 		void put(const K &key, const V &value) {
-			Entry *entry = find(key);
-			if (entry) {
-				entry->_key = key;
-				entry->_value = value;
+			Slot *slot = find(key);
+			if (slot) {
+				slot->_key = key;
+				slot->_value = value;
 			} else {
-				entry = new(__FILE__, __LINE__) Entry();
-				entry->_key = key;
-				entry->_value = value;
-
-				Entry *oldHead = _head;
-
-				if (oldHead) {
-					_head = entry;
-					oldHead->prev = entry;
-					entry->next = oldHead;
-				} else {
-					_head = entry;
-				}
-				_size++;
+				insert(key, value);
 			}
 		}
 
@@ -144,25 +181,28 @@ namespace spine {
 		}
 
 		bool remove(const K &key) {
-			Entry *entry = find(key);
-			if (!entry) return false;
-
-			Entry *prev = entry->prev;
-			Entry *next = entry->next;
-
-			if (prev) prev->next = next;
-			else _head = next;
-			if (next) next->prev = entry->prev;
-
-			delete entry;
+			Slot *slot = find(key);
+			if (!slot) return false;
+
+			// Shift the following displaced slots back by one instead of leaving a tombstone.
+			size_t index = (size_t) (slot - _slots);
+			size_t mask = _capacity - 1;
+			_slots[index].~Slot();
+			for (size_t next = (index + 1) & mask; _distances[next] > 1; next = (next + 1) & mask) {
+				new (&_slots[index]) Slot(_slots[next]);
+				_slots[next].~Slot();
+				_distances[index] = (uint8_t) (_distances[next] - 1);
+				index = next;
+			}
+			_distances[index] = 0;
 			_size--;
 
 			return true;
 		}
 
 		V operator[](const K &key) {
-			Entry *entry = find(key);
-			if (entry) return entry->_value;
+			Slot *slot = find(key);
+			if (slot) return slot->_value;
 			else {
 				assert(false);
 				return 0;
@@ -170,29 +210,90 @@ namespace spine {
 		}
 
 		Entries getEntries() const {
-			return Entries(_head);
+			return Entries(const_cast<HashMap *>(this));
 		}
 
 	private:
-		Entry *find(const K &key) {
-			for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-				if (entry->_key == key)
-					return entry;
+		HashMap(const HashMap &);
+
+		HashMap &operator=(const HashMap &);
+
+		Slot *find(const K &key) {
+			if (_size == 0) return NULL;
+
+			size_t mask = _capacity - 1;
+			size_t index = HashMapHash<K>::hash(key) & mask;
+			for (size_t distance = 1; distance <= _distances[index]; distance++) {
+				if (_distances[index] == distance && _slots[index]._key == key) return &_slots[index];
+				index = (index + 1) & mask;
 			}
 			return NULL;
 		}
 
-		class SP_API Entry : public SpineObject {
-		public:
-			K _key;
-			V _value;
-			Entry *next;
-			Entry *prev;
+		/// Inserts a key that is known to be absent.
+		void insert(const K &key, const V &value) {
+			// Keep the load factor at or below 7/8.
+			if ((_size + 1) * 8 > _capacity * 7) rehash(_capacity ? _capacity * 2 : MinCapacity);
+
+			size_t mask = _capacity - 1;
+			size_t index = HashMapHash<K>::hash(key) & mask;
+			K carryKey(key);
+			V carryValue(value);
+			uint8_t distance = 1;
+			while (true) {
+				if (_distances[index] == 0) {
+					new (&_slots[index]) Slot(carryKey, carryValue);
+					_distances[index] = distance;
+					_size++;
+					return;
+				}
 
-			Entry() : next(NULL), prev(NULL) {}
-		};
+				// Robin Hood: the entry further from its home keeps the slot, the other one moves on.
+				if (_distances[index] < distance) {
+					K key2 = _slots[index]._key;
+					V value2 = _slots[index]._value;
+					_slots[index]._key = carryKey;
+					_slots[index]._value = carryValue;
+					carryKey = key2;
+					carryValue = value2;
+					uint8_t distance2 = _distances[index];
+					_distances[index] = distance;
+					distance = distance2;
+				}
+
+				index = (index + 1) & mask;
+				if (++distance == MaxDistance) {
+					rehash(_capacity * 2);
+					insert(carryKey, carryValue);
+					return;
+				}
+			}
+		}
+
+		void rehash(size_t newCapacity) {
+			Slot *oldSlots = _slots;
+			uint8_t *oldDistances = _distances;
+			size_t oldCapacity = _capacity;
+
+			_slots = SpineExtension::alloc<Slot>(newCapacity, __FILE__, __LINE__);
+			_distances = SpineExtension::calloc<uint8_t>(newCapacity, __FILE__, __LINE__);
+			_capacity = newCapacity;
+			_size = 0;
+
+			for (size_t i = 0; i < oldCapacity; i++) {
+				if (oldDistances[i]) {
+					insert(oldSlots[i]._key, oldSlots[i]._value);
+					oldSlots[i].~Slot();
+				}
+			}
+
+			if (oldSlots) SpineExtension::free(oldSlots, __FILE__, __LINE__);
+			if (oldDistances) SpineExtension::free(oldDistances, __FILE__, __LINE__);
+		}
 
-		Entry *_head;
+		Slot *_slots;
+		uint8_t *_distances;
+		size_t _capacity;
 		size_t _size;
 	};
 }
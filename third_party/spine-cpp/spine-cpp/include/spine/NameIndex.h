@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_NameIndex_h
+#define Spine_NameIndex_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/HashMap.h>
+
+#include <assert.h>
+
+namespace spine {
+	/// Returns the name an item is indexed by. Specialize for items that do not provide getName().
+	template<typename T>
+	struct NameOf {
+		static const String &get(T *item) { return item->getName(); }
+	};
+
+	/// Name to index lookup for a vector of named items, replacing linear string compares.
+	///
+	/// The table stores indices into the vector, not names, so it never holds stale string pointers.
+	/// The loaders presize the vectors and fill them front to back: only the filled (non-NULL) prefix is
+	/// indexed, items filled since the last lookup are hashed on the next find(), so every name is hashed
+	/// exactly once. If the vector shrank, the table is rebuilt. When names repeat, the first item wins,
+	/// matching ContainerUtil::findWithName.
+	///
+	/// Replacing or renaming an item without changing the size is not visible here. Owners call clear() on
+	/// every path that hands the vector out for modification; the next find() then rehashes.
+	///
+	/// The returned index is a stable handle: resolve a name once and keep the integer.
+	template<typename T>
+	class SP_API NameIndex : public SpineObject {
+	public:
+		NameIndex() : _count(0), _mask(0) {
+		}
+
+		/// @return -1 if the item was not found.
+		int find(Vector<T *> &items, const String &name) {
+			assert(name.length() > 0);
+
+			update(items);
+			if (_slots.size() == 0) return -1;
+
+			size_t hash = name.hash();
+			for (size_t i = hashMix(hash) & _mask;; i = (i + 1) & _mask) {
+				int index = _slots[i];
+				if (index == -1) return -1;
+				if (_hashes[i] == hash && NameOf<T>::get(items[index]) == name) return index;
+			}
+		}
+
+		/// Hashes any items not indexed yet. find() does this implicitly.
+		void build(Vector<T *> &items) {
+			update(items);
+		}
+
+		void clear() {
+			_slots.clear();
+			_hashes.clear();
+			_count = 0;
+			_mask = 0;
+		}
+
+	private:
+		void update(Vector<T *> &items) {
+			size_t size = items.size();
+			if (size == _count) return;
+			if (size < _count) clear();
+
+			// Keep the load factor at or below 1/2.
+			if (size * 2 > _slots.size()) {
+				size_t capacity = 16;
+				while (capacity < size * 2) capacity <<= 1;
+				_slots.setSize(capacity, -1);
+				_hashes.setSize(capacity, 0);
+				for (size_t i = 0; i < capacity; i++) _slots[i] = -1;
+				_mask = capacity - 1;
+				_count = 0;
+			}
+
+			for (; _count < size && items[_count]; _count++) insert(NameOf<T>::get(items[_count]), (int) _count, items);
+		}
+
+		void insert(const String &name, int index, Vector<T *> &items) {
+			size_t hash = name.hash();
+			size_t i = hashMix(hash) & _mask;
+			for (; _slots[i] != -1; i = (i + 1) & _mask) {
+				if (_hashes[i] == hash && NameOf<T>::get(items[_slots[i]]) == name) return;
+			}
+			_slots[i] = index;
+			_hashes[i] = hash;
+		}
+
+		Vector<int> _slots;
+		Vector<size_t> _hashes;
+		size_t _count;
+		size_t _mask;
+	};
+}
+
+#endif /* Spine_NameIndex_h */
@@ -280,6 +280,8 @@ namespace spine {
         void setFrame(int frame, float time) {
             _frames[frame] = time;
         }
+
+        int getPhysicsConstraintIndex() { return _constraintIndex; }
     private:
         int _constraintIndex;
     };
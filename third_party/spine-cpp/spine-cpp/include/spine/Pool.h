@@ -35,7 +35,11 @@
 #include <spine/ContainerUtil.h>
 #include <spine/SpineObject.h>
 
+#include <assert.h>
+
 namespace spine {
+	/// Stack of free T objects. Obtain and free are constant time. Freeing an object twice is not checked unless
+	/// SPINE_DEBUG_POOL is defined, in which case it asserts.
 	template<typename T>
 	class SP_API Pool : public SpineObject {
 	public:
@@ -61,11 +65,25 @@ namespace spine {
 		}
 
 		void free(T *object) {
-			if (!_objects.contains(object)) {
-				_objects.add(object);
+#ifdef SPINE_DEBUG_POOL
+			assert(!_objects.contains(object) && "Object freed to the pool twice");
+#endif
+			_objects.add(object);
+		}
+
+		/// Creates objects until at least capacity are free, so that obtaining and freeing up to capacity objects
+		/// does not allocate.
+		void prewarm(size_t capacity) {
+			_objects.ensureCapacity(capacity);
+			while (_objects.size() < capacity) {
+				_objects.add(new(__FILE__, __LINE__) T());
 			}
 		}
 
+		size_t getFreeCount() {
+			return _objects.size();
+		}
+
 	private:
 		Vector<T *> _objects;
 	};
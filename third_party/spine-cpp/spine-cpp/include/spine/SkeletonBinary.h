@@ -63,7 +63,11 @@ namespace spine {
 
 	class Sequence;
 
+	class BinaryAnimationSource;
+
 	class SP_API SkeletonBinary : public SpineObject {
+		friend class BinaryAnimationSource;
+
 	public:
 		static const int BONE_ROTATE = 0;
 		static const int BONE_TRANSLATE = 1;
@@ -116,6 +120,11 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, animations are only scanned for their duration while reading. Their timelines are decoded on
+		/// first use, see Animation::load(). The animation section of the data is kept in memory (or mapped, when
+		/// read with readSkeletonDataFile()) until the SkeletonData is deleted. Default is false.
+		void setLazyAnimations(bool lazy) { _lazyAnimations = lazy; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -124,11 +133,21 @@ namespace spine {
 			const unsigned char *end;
 		};
 
+		enum BufferOwnership {
+			BufferBorrowed,
+			BufferAllocated,
+			BufferMapped
+		};
+
 		AttachmentLoader *_attachmentLoader;
 		Vector<LinkedMesh *> _linkedMeshes;
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		bool _lazyAnimations;
+
+		/// Lazily loaded animations take over an allocated or mapped buffer, a borrowed buffer is copied.
+		SkeletonData *readSkeletonData(const unsigned char *binary, int length, BufferOwnership ownership);
 
 		void setError(const char *value1, const char *value2);
 
@@ -165,6 +184,12 @@ namespace spine {
 
 		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData);
 
+		bool readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines);
+
+		float skipCurveFrames(DataInput *input, int frameCount, int valueBytes, int curveCount);
+
+		bool skipTimelines(DataInput *input, SkeletonData *skeletonData, float &duration);
+
 		void
 		setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1, float time2,
 				  float value1, float value2, float scale);
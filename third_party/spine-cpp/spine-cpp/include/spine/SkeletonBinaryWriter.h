@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonBinaryWriter_h
+#define Spine_SkeletonBinaryWriter_h
+
+#include <spine/Vector.h>
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Color.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class Skin;
+
+	class Attachment;
+
+	class VertexAttachment;
+
+	class Sequence;
+
+	class Animation;
+
+	class Timeline;
+
+	class CurveTimeline;
+
+	/// Writes SkeletonData in the binary format read by SkeletonBinary, e.g. to cache skeletons exported as JSON so
+	/// later loads skip the JSON parse. The data must have been read with a scale of 1. Colors are stored with 8 bits
+	/// per channel and bezier control points are recovered from the sampled curves, so values read back can differ
+	/// from the source in the last bits. The skeleton hash is not preserved.
+	class SP_API SkeletonBinaryWriter : public SpineObject {
+	public:
+		SkeletonBinaryWriter();
+
+		~SkeletonBinaryWriter();
+
+		/// Replaces the contents of output with the serialized skeleton data.
+		/// @return False if the data cannot be represented in the binary format, see getError().
+		bool writeSkeletonData(SkeletonData &skeletonData, Vector<unsigned char> &output);
+
+		String &getError() { return _error; }
+
+	private:
+		SkeletonData *_skeletonData;
+		Vector<unsigned char> *_output;
+		Vector<String> _strings;
+		HashMap<String, int> _stringIndex;
+		bool _defaultSkinSkipped;
+		String _error;
+
+		void setError(const char *value1, const char *value2);
+
+		void writeByte(int value);
+
+		void writeBoolean(bool value);
+
+		void writeInt(int value);
+
+		void writeFloat(float value);
+
+		void writeVarint(int value, bool optimizePositive);
+
+		void writeString(const String &value);
+
+		void writeStringRef(const String &value);
+
+		void writeColor(const Color &color);
+
+		int skinIndex(Skin *skin);
+
+		bool findAttachment(Attachment *attachment, int slotIndex, int &skinIndex, String &name);
+
+		bool writeSkin(Skin &skin, bool defaultSkin);
+
+		void writeSequence(Sequence *sequence);
+
+		bool writeAttachment(const String &key, Attachment *attachment, int slotIndex);
+
+		void writeVertices(VertexAttachment &attachment);
+
+		bool writeAnimation(Animation &animation);
+
+		void writeCurveFrames(CurveTimeline &timeline, int valueCount, bool colorBytes);
+
+		void writeCurve(CurveTimeline &timeline, int frame, int valueCount);
+
+		void writeBeziers(CurveTimeline &timeline, int frame, int valueCount);
+	};
+}
+
+#endif /* Spine_SkeletonBinaryWriter_h */
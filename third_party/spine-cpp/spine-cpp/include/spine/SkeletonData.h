@@ -32,6 +32,7 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
+#include <spine/NameIndex.h>
 
 namespace spine {
 	class BoneData;
@@ -44,6 +45,8 @@ namespace spine {
 
 	class Animation;
 
+	class AnimationSource;
+
 	class IkConstraintData;
 
 	class TransformConstraintData;
@@ -65,8 +68,9 @@ namespace spine {
 
 		~SkeletonData();
 
-		/// Finds a bone by comparing each bone's name.
-		/// It is more efficient to cache the results of this method than to call it multiple times.
+		/// Finds a bone by name. Lookups go through a hash index that is built once after loading. The mutable getters
+		/// below (getBones(), getSlots(), ...) drop the matching index, so it is rebuilt on the next lookup after the
+		/// vector has been edited.
 		/// @return May be NULL.
 		BoneData *findBone(const String &boneName);
 
@@ -79,6 +83,7 @@ namespace spine {
 		/// @return May be NULL.
 		spine::EventData *findEvent(const String &eventDataName);
 
+		/// Decodes the animation's timelines if it was loaded lazily, see Animation::load().
 		/// @return May be NULL.
 		Animation *findAnimation(const String &animationName);
 
@@ -94,6 +99,23 @@ namespace spine {
         /// @return May be NULL.
         PhysicsConstraintData *findPhysicsConstraint(const String &constraintName);
 
+		/// Index handles: resolve a name once and keep the integer. The index is valid for getBones(),
+		/// getSlots(), ... of this data and for Skeleton::getBones()/getSlots() of skeletons created from it.
+		/// @return -1 if not found.
+		int findBoneIndex(const String &boneName);
+
+		/// @return -1 if not found.
+		int findSlotIndex(const String &slotName);
+
+		/// @return -1 if not found.
+		int findSkinIndex(const String &skinName);
+
+		/// @return -1 if not found.
+		int findEventIndex(const String &eventDataName);
+
+		/// @return -1 if not found.
+		int findAnimationIndex(const String &animationName);
+
 		const String &getName();
 
 		void setName(const String &inValue);
@@ -115,8 +137,12 @@ namespace spine {
 
 		Vector<spine::EventData *> &getEvents();
 
+		/// Animations loaded lazily have no timelines until Animation::load() is called.
 		Vector<Animation *> &getAnimations();
 
+		/// Releases the timelines of all lazily loaded animations, see Animation::release().
+		void releaseAnimations();
+
 		Vector<IkConstraintData *> &getIkConstraints();
 
 		Vector<TransformConstraintData *> &getTransformConstraints();
@@ -175,6 +201,7 @@ namespace spine {
 		Skin *_defaultSkin;
 		Vector<EventData *> _events;
 		Vector<Animation *> _animations;
+		AnimationSource *_animationSource; // Decodes lazily loaded animations, may be NULL.
 		Vector<IkConstraintData *> _ikConstraints;
 		Vector<TransformConstraintData *> _transformConstraints;
 		Vector<PathConstraintData *> _pathConstraints;
@@ -185,6 +212,16 @@ namespace spine {
 		String _hash;
 		Vector<char *> _strings;
 
+		NameIndex<BoneData> _boneIndex;
+		NameIndex<SlotData> _slotIndex;
+		NameIndex<Skin> _skinIndex;
+		NameIndex<EventData> _eventIndex;
+		NameIndex<Animation> _animationIndex;
+		NameIndex<IkConstraintData> _ikConstraintIndex;
+		NameIndex<TransformConstraintData> _transformConstraintIndex;
+		NameIndex<PathConstraintData> _pathConstraintIndex;
+		NameIndex<PhysicsConstraintData> _physicsConstraintIndex;
+
 		// Nonessential.
 		float _fps;
 		String _imagesPath;
@@ -36,6 +36,7 @@
 
 namespace spine {
     class Skeleton;
+    class Slot;
 
     struct SP_API RenderCommand {
         float *positions;
@@ -50,6 +51,41 @@ namespace spine {
         RenderCommand *next;
     };
 
+    /// Interleaved vertex written by SkeletonRenderer::render(Skeleton &, RenderSink &).
+    struct SP_API RenderVertex {
+        float x, y;
+        float u, v;
+        uint32_t color;
+        uint32_t darkColor;
+    };
+
+    /// A range of sink indices sharing a texture and blend mode.
+    struct SP_API RenderBatch {
+        void *texture;
+        BlendMode blendMode;
+        uint32_t firstIndex;
+        uint32_t numIndices;
+    };
+
+    /// Caller-supplied destination for skeleton geometry, e.g. a mapped vertex buffer or a preallocated array.
+    /// Vertices and indices are written directly into the returned storage exactly once. Storage returned by one
+    /// function must stay valid until that same function is called again.
+    class SP_API RenderSink {
+    public:
+        virtual ~RenderSink() {}
+
+        /// Returns storage for count vertices, or NULL if the sink is full. firstVertex receives the sink index of the
+        /// first vertex, which is added to the indices written for them.
+        virtual RenderVertex *allocateVertices(int count, uint32_t &firstVertex) = 0;
+
+        /// Returns storage for count indices, or NULL if the sink is full. firstIndex receives the sink index of the
+        /// first one.
+        virtual uint32_t *allocateIndices(int count, uint32_t &firstIndex) = 0;
+
+        /// Called once per batch, in draw order, after the batch's geometry has been written.
+        virtual void addBatch(const RenderBatch &batch) = 0;
+    };
+
     class SP_API SkeletonRenderer: public SpineObject {
     public:
         explicit SkeletonRenderer();
@@ -57,7 +93,27 @@ namespace spine {
         ~SkeletonRenderer();
 
         RenderCommand *render(Skeleton &skeleton);
+
+        /// Writes the skeleton's geometry into the sink without allocating render commands. Consecutive attachments with
+        /// the same texture and blend mode form one batch. Returns false if the sink ran out of space; batches emitted
+        /// before that are complete.
+        bool render(Skeleton &skeleton, RenderSink &sink);
     private:
+        struct SlotGeometry {
+            Vector<float> *vertices;
+            Vector<float> *uvs;
+            Vector<unsigned short> *indices;
+            int32_t verticesCount;
+            int32_t indicesCount;
+            uint32_t color;
+            uint32_t darkColor;
+            void *texture;
+        };
+
+        /// Computes the world vertices of the slot's attachment, clipped if needed. Returns false if the slot draws
+        /// nothing; otherwise the caller must call _clipping.clipEnd(slot) once the geometry has been consumed.
+        bool computeSlot(Skeleton &skeleton, Slot &slot, SlotGeometry &geometry);
+
         BlockAllocator _allocator;
         Vector<float> _worldVertices;
         Vector<unsigned short> _quadIndices;
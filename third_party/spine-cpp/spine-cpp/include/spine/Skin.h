@@ -58,11 +58,13 @@ namespace spine {
 				size_t _slotIndex;
 				String _name;
 				Attachment *_attachment;
+				size_t _hash; // Hash of _name, compared before the name itself.
 
 				Entry(size_t slotIndex, const String &name, Attachment *attachment) :
 						_slotIndex(slotIndex),
 						_name(name),
-						_attachment(attachment) {
+						_attachment(attachment),
+						_hash(_name.hash()) {
 				}
 			};
 
@@ -110,10 +112,22 @@ namespace spine {
 			AttachmentMap();
 
 		private:
+			/// Position of an entry in _buckets. slotIndex is -1 for an empty index slot.
+			struct IndexEntry {
+				int slotIndex;
+				int position;
+			};
+
+			int find(size_t slotIndex, const String &attachmentName, size_t hash);
+
+			void insertIndex(size_t slotIndex, size_t hash, int position);
 
-			int findInBucket(Vector <Entry> &, const String &attachmentName);
+			void rebuildIndex();
 
 			Vector <Vector<Entry>> _buckets;
+			/// Open addressing over (slot index, name hash), at most half full. Capacity is a power of two.
+			Vector <IndexEntry> _index;
+			size_t _count;
 		};
 
 		explicit Skin(const String &name);
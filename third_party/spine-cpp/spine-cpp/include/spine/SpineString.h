@@ -35,39 +35,40 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 
 namespace spine {
+	/// Characters are stored inline when shorter than SmallCapacity, otherwise in a heap buffer. Strings returned by
+	/// intern() share one process-wide buffer per distinct name: copying them does not allocate and two interned
+	/// strings compare by pointer.
 	class SP_API String : public SpineObject {
 	public:
-		String() : _length(0), _buffer(NULL), _tempowner(true) {
+		String() : _length(0), _buffer(NULL), _tempowner(true), _interned(false), _inline(false) {
 		}
 
-		String(const char *chars, bool own = false, bool tofree = true) {
+		String(const char *chars, bool own = false, bool tofree = true) : _buffer(NULL), _interned(false), _inline(false) {
 			_tempowner = tofree;
 			if (!chars) {
 				_length = 0;
 				_buffer = NULL;
+			} else if (!own) {
+				copyChars(chars, strlen(chars));
 			} else {
 				_length = strlen(chars);
-				if (!own) {
-					_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-					memcpy((void *) _buffer, chars, _length + 1);
-				} else {
-					_buffer = (char *) chars;
-				}
+				_buffer = (char *) chars;
 			}
 		}
 
-		String(const String &other) {
-			_tempowner = true;
-			if (!other._buffer) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
-			}
+		String(const String &other) : _buffer(NULL), _tempowner(true), _interned(false), _inline(false) {
+			assign(other);
+		}
+
+		/// Returns a string sharing the canonical buffer for these characters. Canonical buffers live for the rest of
+		/// the process, so intern only names from loaded data, not arbitrary text. Thread safe.
+		static String intern(const String &chars);
+
+		bool isInterned() const {
+			return _interned;
 		}
 
 		size_t length() const {
@@ -79,25 +80,44 @@ namespace spine {
 		}
 
 		const char *buffer() const {
-			return _buffer;
+			return _inline ? _small : _buffer;
+		}
+
+		/// FNV-1a hash of the characters. Interned strings return the hash stored with the canonical buffer.
+		size_t hash() const {
+			if (_interned) {
+				size_t stored;
+				memcpy(&stored, _buffer - sizeof(size_t), sizeof(size_t));
+				return stored;
+			}
+			const char *chars = buffer();
+			uint64_t hash = 14695981039346656037ULL;
+			for (size_t i = 0; i < _length; i++) {
+				hash ^= (unsigned char) chars[i];
+				hash *= 1099511628211ULL;
+			}
+			return (size_t) hash;
 		}
 
 		void own(const String &other) {
 			if (this == &other) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			release();
 			_length = other._length;
-			_buffer = other._buffer;
+			_interned = other._interned;
+			_inline = other._inline;
+			if (_inline)
+				memcpy(_small, other._small, _length + 1);
+			else
+				_buffer = other._buffer;
 			other._length = 0;
 			other._buffer = NULL;
+			other._interned = false;
+			other._inline = false;
 		}
 
 		void own(const char *chars) {
-			if (_buffer == chars) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			if (buffer() == chars) return;
+			release();
 
 			if (!chars) {
 				_length = 0;
@@ -111,58 +131,35 @@ namespace spine {
 		void unown() {
 			_length = 0;
 			_buffer = NULL;
+			_interned = false;
+			_inline = false;
 		}
 
 		String &operator=(const String &other) {
 			if (this == &other) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			if (!other._buffer) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
-				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
-			}
+			release();
+			assign(other);
 			return *this;
 		}
 
 		String &operator=(const char *chars) {
-			if (_buffer == chars) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			if (buffer() == chars) return *this;
+			release();
 			if (!chars) {
 				_length = 0;
 				_buffer = NULL;
 			} else {
-				_length = strlen(chars);
-				_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, chars, _length + 1);
+				copyChars(chars, strlen(chars));
 			}
 			return *this;
 		}
 
 		String &append(const char *chars) {
-			size_t len = strlen(chars);
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = chars == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : chars), len + 1);
-			return *this;
+			return appendChars(chars, strlen(chars));
 		}
 
 		String &append(const String &other) {
-			size_t len = other.length();
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = other._buffer == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : other._buffer), len + 1);
-			return *this;
+			return appendChars(other.buffer(), other.length());
 		}
 
 		String &append(int other) {
@@ -198,28 +195,27 @@ namespace spine {
             if (startIndex < 0 || startIndex >= (int)_length || length < 0 || startIndex + length > (int)_length) {
                 return String();
             }
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String result;
+            result.copyChars(buffer() + startIndex, length);
+            return result;
         }
 
         String substring(int startIndex) const {
             if (startIndex < 0 || startIndex >= (int)_length) {
                 return String();
             }
-            int length = (int)_length - startIndex;
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String result;
+            result.copyChars(buffer() + startIndex, _length - startIndex);
+            return result;
         }
 
 		friend bool operator==(const String &a, const String &b) {
-			if (a._buffer == b._buffer) return true;
+			const char *aChars = a.buffer(), *bChars = b.buffer();
+			if (aChars == bChars) return true;
+			if (a._interned && b._interned) return false;
 			if (a._length != b._length) return false;
-			if (a._buffer && b._buffer) {
-				return strcmp(a._buffer, b._buffer) == 0;
+			if (aChars && bChars) {
+				return memcmp(aChars, bChars, a._length) == 0;
 			} else {
 				return false;
 			}
@@ -230,15 +226,82 @@ namespace spine {
 		}
 
 		~String() {
-			if (_buffer && _tempowner) {
+			release();
+		}
+
+		static const size_t SmallCapacity = 16;
+
+	private:
+		void release() {
+			if (_buffer && _tempowner && !_interned && !_inline) {
 				SpineExtension::free(_buffer, __FILE__, __LINE__);
 			}
+			_buffer = NULL;
+			_interned = false;
+			_inline = false;
+		}
+
+		/// Copies into inline storage when short enough, otherwise into a new heap buffer. Expects a released string.
+		void copyChars(const char *chars, size_t length) {
+			_length = length;
+			char *target;
+			if (length < SmallCapacity) {
+				_inline = true;
+				target = _small;
+			} else {
+				_buffer = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
+				target = _buffer;
+			}
+			memcpy(target, chars, length);
+			target[length] = '\0';
+		}
+
+		void assign(const String &other) {
+			if (other._interned) {
+				// Interned buffers are shared, never copied
+				_length = other._length;
+				_buffer = other._buffer;
+				_interned = true;
+			} else if (!other.buffer()) {
+				_length = 0;
+				_buffer = NULL;
+			} else {
+				copyChars(other.buffer(), other._length);
+			}
+		}
+
+		String &appendChars(const char *chars, size_t len) {
+			size_t thisLen = _length;
+			size_t newLength = thisLen + len;
+			if (_buffer && _tempowner && !_interned && !_inline) {
+				bool same = chars == _buffer;
+				_buffer = SpineExtension::realloc(_buffer, newLength + 1, __FILE__, __LINE__);
+				if (len > 0) memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : chars), len);
+				_buffer[newLength] = '\0';
+			} else {
+				// Inline, interned and borrowed characters are never resized in place
+				const char *old = buffer();
+				char *target = newLength < SmallCapacity ? _small : SpineExtension::calloc<char>(newLength + 1, __FILE__, __LINE__);
+				if (target != old && thisLen > 0) memcpy(target, old, thisLen);
+				if (len > 0) memcpy(target + thisLen, chars == old ? target : chars, len);
+				target[newLength] = '\0';
+				_interned = false;
+				_inline = target == _small;
+				if (!_inline) {
+					_buffer = target;
+					_tempowner = true;
+				}
+			}
+			_length = newLength;
+			return *this;
 		}
 
-	private:
 		mutable size_t _length;
-		mutable char *_buffer;
+		mutable char *_buffer; // Heap, borrowed or interned characters. Unused while _inline.
 		mutable bool _tempowner;
+		mutable bool _interned;
+		mutable bool _inline;
+		char _small[SmallCapacity];
 	};
 }
 
@@ -85,6 +85,13 @@ namespace spine {
 
 		void copyTo(VertexAttachment *other);
 
+		/// Repacks weighted vertices for the vectorized path of computeWorldVertices (SSE2, or AVX2 when the CPU
+		/// supports it). Vertices are grouped in blocks of 8 and each block stores the k-th influence of its
+		/// vertices together, so the vertices of a block are skinned side by side with the same per vertex
+		/// summation order as the scalar loop and bit identical results. The loaders call this; call it again
+		/// after changing getBones() or getVertices().
+		void prepareWeights();
+
 	protected:
 		Vector <int> _bones;
 		Vector<float> _vertices;
@@ -94,7 +101,19 @@ namespace spine {
 	private:
 		const int _id;
 
+		// Packed weights, empty when unweighted or not prepared. Per block: first slot, slot count, 8 lane
+		// influence counts. Per slot: 8 lane offsets into the bone transform table, 8 influence indices (for
+		// deform), and 8 x, 8 y, 8 weights.
+		Vector<int> _weightBlocks;
+		Vector<int> _weightSlots;
+		Vector<float> _weightValues;
+		Vector<int> _weightBoneIndices; // Skeleton bone index of each transform table entry.
+		size_t _weightVerticesSize; // _vertices.size() when packed, to detect later edits.
+
 		static int getNextID();
+
+		bool computeWeightedPacked(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
+								   size_t stride);
 	};
 }
 
@@ -68,6 +68,7 @@
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
+#include <spine/NameIndex.h>
 #include <spine/PathAttachment.h>
 #include <spine/PathConstraint.h>
 #include <spine/PathConstraintData.h>
@@ -89,6 +90,7 @@
 #include <spine/ShearTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonBinary.h>
+#include <spine/SkeletonBinaryWriter.h>
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
@@ -41,15 +41,54 @@ using namespace spine;
 Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(timelines),
 																						  _timelineIds(),
 																						  _duration(duration),
-																						  _name(name) {
+																						  _name(name),
+																						  _source(NULL),
+																						  _sourceIndex(-1),
+																						  _loaded(true) {
 	assert(_name.length() > 0);
-	for (size_t i = 0; i < timelines.size(); i++) {
-		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
+	indexTimelines();
+}
+
+Animation::Animation(const String &name, float duration, AnimationSource *source, int sourceIndex) : _timelines(),
+																									  _timelineIds(),
+																									  _duration(duration),
+																									  _name(name),
+																									  _source(source),
+																									  _sourceIndex(sourceIndex),
+																									  _loaded(false) {
+	assert(_name.length() > 0);
+	assert(_source != NULL);
+}
+
+void Animation::indexTimelines() {
+	for (size_t i = 0; i < _timelines.size(); i++) {
+		Vector<PropertyId> propertyIds = _timelines[i]->getPropertyIds();
 		for (size_t ii = 0; ii < propertyIds.size(); ii++)
 			_timelineIds.put(propertyIds[ii], true);
 	}
 }
 
+bool Animation::isLoaded() {
+	return _loaded;
+}
+
+bool Animation::load() {
+	if (_loaded) return true;
+	Vector<Timeline *> timelines;
+	if (!_source->loadTimelines(*this, _sourceIndex, timelines)) return false;
+	_timelines.clearAndAddAll(timelines);
+	indexTimelines();
+	_loaded = true;
+	return true;
+}
+
+void Animation::release() {
+	if (!_source || !_loaded) return;
+	ContainerUtil::cleanUpVectorOfPointers(_timelines);
+	_timelineIds.clear();
+	_loaded = false;
+}
+
 bool Animation::hasTimeline(Vector<PropertyId> &ids) {
 	for (size_t i = 0; i < ids.size(); i++) {
 		if (_timelineIds.containsKey(ids[i])) return true;
@@ -92,16 +131,45 @@ void Animation::setDuration(float inValue) {
 }
 
 int Animation::search(Vector<float> &frames, float target) {
-	size_t n = (int) frames.size();
-	for (size_t i = 1; i < n; i++) {
-		if (frames[i] > target) return (int) (i - 1);
-	}
-	return (int) (n - 1);
+	return search(frames, target, 1);
 }
 
+// The cursor of the innermost SearchCursor on this thread, NULL if there is none.
+static thread_local int *currentCursor = NULL;
+
 int Animation::search(Vector<float> &frames, float target, int step) {
-	size_t n = frames.size();
-	for (size_t i = step; i < n; i += step)
-		if (frames[i] > target) return (int) (i - step);
-	return (int) (n - step);
+	int count = (int) frames.size() / step;
+	int *cursor = currentCursor;
+	if (cursor) {
+		// Forward playback: the frame found last time, or the one after it.
+		int frame = *cursor;
+		if (frame >= 0 && frame < count && (frame == 0 || frames[frame * step] <= target)) {
+			for (int end = frame + 2 < count ? frame + 2 : count; frame < end; frame++) {
+				if (frame + 1 == count || frames[(frame + 1) * step] > target) {
+					*cursor = frame;
+					return frame * step;
+				}
+			}
+		}
+	}
+
+	// Number of frames after the first whose time is <= target.
+	int low = 1, high = count;
+	while (low < high) {
+		int middle = (low + high) >> 1;
+		if (frames[middle * step] > target)
+			high = middle;
+		else
+			low = middle + 1;
+	}
+	if (cursor) *cursor = low - 1;
+	return (low - 1) * step;
+}
+
+Animation::SearchCursor::SearchCursor(int &frame) : _previous(currentCursor) {
+	currentCursor = &frame;
+}
+
+Animation::SearchCursor::~SearchCursor() {
+	currentCursor = _previous;
 }
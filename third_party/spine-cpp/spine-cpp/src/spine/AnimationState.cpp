@@ -207,6 +207,7 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_timelineCursors.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -466,10 +467,13 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		}
 		size_t timelineCount = current._animation->_timelines.size();
 		Vector<Timeline *> &timelines = current._animation->_timelines;
+		if (current._timelineCursors.size() != timelineCount) current._timelineCursors.setSize(timelineCount, 0);
+		Vector<int> &timelineCursors = current._timelineCursors;
 		if ((i == 0 && alpha == 1) || blend == MixBlend_Add) {
 			if (i == 0) attachments = true;
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
+				Animation::SearchCursor cursor(timelineCursors[ii]);
 				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
 					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, blend,
 											attachments);
@@ -487,6 +491,7 @@ bool AnimationState::apply(Skeleton &skeleton) {
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
 				assert(timeline);
+				Animation::SearchCursor cursor(timelineCursors[ii]);
 
 				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
 
@@ -567,6 +572,7 @@ TrackEntry *AnimationState::setAnimation(size_t trackIndex, const String &animat
 
 TrackEntry *AnimationState::setAnimation(size_t trackIndex, Animation *animation, bool loop) {
 	assert(animation != NULL);
+	animation->load();
 
 	bool interrupt = true;
 	TrackEntry *current = expandToIndex(trackIndex);
@@ -599,6 +605,7 @@ TrackEntry *AnimationState::addAnimation(size_t trackIndex, const String &animat
 
 TrackEntry *AnimationState::addAnimation(size_t trackIndex, Animation *animation, bool loop, float delay) {
 	assert(animation != NULL);
+	animation->load();
 
 	TrackEntry *last = expandToIndex(trackIndex);
 	if (last != NULL) {
@@ -701,6 +708,10 @@ void AnimationState::disposeTrackEntry(TrackEntry *entry) {
 	_trackEntryPool.free(entry);
 }
 
+void AnimationState::prewarmTrackEntries(size_t count) {
+	_trackEntryPool.prewarm(count);
+}
+
 Animation *AnimationState::getEmptyAnimation() {
 	static Vector<Timeline *> timelines;
 	static Animation ret(String("<empty>"), timelines, 0);
@@ -848,9 +859,14 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 		if (mix < from->_eventThreshold) events = &_events;
 	}
 
+	if (from->_timelineCursors.size() != timelineCount) from->_timelineCursors.setSize(timelineCount, 0);
+	Vector<int> &timelineCursors = from->_timelineCursors;
+
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
+		for (size_t i = 0; i < timelineCount; i++) {
+			Animation::SearchCursor cursor(timelineCursors[i]);
 			timelines[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
+		}
 	} else {
 		Vector<int> &timelineMode = from->_timelineMode;
 		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
@@ -892,6 +908,7 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 					break;
 			}
 			from->_totalAlpha += alpha;
+			Animation::SearchCursor cursor(timelineCursors[i]);
 			if (!shortestRotation && (timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
 				applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
 									timelinesRotation, i << 1, firstFrame);
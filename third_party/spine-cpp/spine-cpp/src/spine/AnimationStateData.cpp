@@ -84,3 +84,7 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
 	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
 }
+
+size_t AnimationStateData::AnimationPair::hash() const {
+	return hashMix(_a1->_name.hash() * 31 + _a2->_name.hash());
+}
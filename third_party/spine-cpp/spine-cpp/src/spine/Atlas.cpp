@@ -86,9 +86,13 @@ void Atlas::flipV() {
 }
 
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
-	return NULL;
+	int index = findRegionIndex(name);
+	return index == -1 ? NULL : _regions[index];
+}
+
+int Atlas::findRegionIndex(const String &name) {
+	if (name.isEmpty()) return -1;
+	return _regionIndex.find(_regions, name);
 }
 
 Vector<AtlasPage *> &Atlas::getPages() {
@@ -96,9 +100,14 @@ Vector<AtlasPage *> &Atlas::getPages() {
 }
 
 Vector<AtlasRegion *> &Atlas::getRegions() {
+	_regionIndex.clear();
 	return _regions;
 }
 
+void Atlas::invalidateRegionIndex() {
+	_regionIndex.clear();
+}
+
 struct SimpleString {
 	char *start;
 	char *end;
@@ -347,4 +356,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			_regions.add(region);
 		}
 	}
+
+	// Hash all region names once, attachment loaders look them up right after this.
+	_regionIndex.build(_regions);
 }
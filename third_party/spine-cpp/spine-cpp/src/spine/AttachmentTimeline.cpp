@@ -92,7 +92,7 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 
 void AttachmentTimeline::setFrame(int frame, float time, const String &attachmentName) {
 	_frames[frame] = time;
-	_attachmentNames[frame] = attachmentName;
+	_attachmentNames[frame] = String::intern(attachmentName);
 }
 
 Vector<String> &AttachmentTimeline::getAttachmentNames() {
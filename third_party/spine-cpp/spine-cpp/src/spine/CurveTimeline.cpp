@@ -29,16 +29,32 @@
 
 #include <spine/CurveTimeline.h>
 
+#include <spine/Animation.h>
 #include <spine/MathUtil.h>
 
+#if defined(SPINE_NO_SIMD)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPINE_BEZIER_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SPINE_BEZIER_NEON
+#endif
+
 using namespace spine;
 
+static bool bezierLookupEnabled = true;
+
+// Marks a bezier whose sampled times are not monotonic, these use the linear walk.
+static const unsigned char NON_MONOTONIC = 0xFF;
+
 RTTI_IMPL(CurveTimeline, Timeline)
 
 CurveTimeline::CurveTimeline(size_t frameCount, size_t frameEntries, size_t bezierCount) : Timeline(frameCount,
 																									frameEntries) {
 	_curves.setSize(frameCount + bezierCount * BEZIER_SIZE, 0);
 	_curves[frameCount - 1] = STEPPED;
+	if (bezierLookupEnabled) _bezierLookup.setSize(bezierCount * BEZIER_LOOKUP_SIZE, NON_MONOTONIC);
 }
 
 CurveTimeline::~CurveTimeline() {
@@ -56,6 +72,7 @@ void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float ti
 							  float cx2, float cy2, float time2, float value2) {
 	size_t i = getFrameCount() + bezier * BEZIER_SIZE;
 	if (value == 0) _curves[frame] = BEZIER + i;
+	size_t start = i;
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = (value1 - cy1 * 2 + cy2) * 0.03;
 	float dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006, dddy = ((cy1 - cy2) * 3 - value1 + value2) * 0.006;
 	float ddx = tmpx * 2 + dddx, ddy = tmpy * 2 + dddy;
@@ -71,20 +88,95 @@ void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float ti
 		x += dx;
 		y += dy;
 	}
+	buildBezierLookup(start, time1, time2);
+}
+
+void CurveTimeline::setBezierLookup(bool enabled) {
+	bezierLookupEnabled = enabled;
+}
+
+bool CurveTimeline::getBezierLookup() {
+	return bezierLookupEnabled;
+}
+
+void CurveTimeline::buildBezierLookup(size_t i, float time1, float time2) {
+	if (_bezierLookup.size() == 0) return;
+
+	unsigned char *lookup = _bezierLookup.buffer() + (i - getFrameCount()) / BEZIER_SIZE * BEZIER_LOOKUP_SIZE;
+	for (size_t ii = i + 2, n = i + BEZIER_SIZE; ii < n; ii += 2) {
+		if (_curves[ii] < _curves[ii - 2]) {
+			lookup[0] = NON_MONOTONIC;
+			return;
+		}
+	}
+
+	// Segment at the start of each bucket, minus one so rounding in getBezierSegment never lands past the segment.
+	float step = (time2 - time1) / BEZIER_LOOKUP_SIZE;
+	for (int bucket = 0; bucket < BEZIER_LOOKUP_SIZE; bucket++) {
+		size_t segment = getBezierSegmentLinear(time1 + step * bucket, i);
+		lookup[bucket] = (unsigned char) (segment > 0 ? segment - 1 : 0);
+	}
+}
+
+size_t CurveTimeline::getBezierSegmentLinear(float time, size_t i) {
+	if (_curves[i] > time) return 0;
+	size_t segment = 1;
+	for (size_t n = i + BEZIER_SIZE, ii = i + 2; ii < n; ii += 2, segment++)
+		if (_curves[ii] >= time) return segment;
+	return segment;
+}
+
+size_t CurveTimeline::getBezierSegment(float time, size_t frame, size_t i) {
+	if (_bezierLookup.size() == 0) return getBezierSegmentLinear(time, i);
+	const unsigned char *lookup = _bezierLookup.buffer() + (i - getFrameCount()) / BEZIER_SIZE * BEZIER_LOOKUP_SIZE;
+	if (lookup[0] == NON_MONOTONIC) return getBezierSegmentLinear(time, i);
+
+	const float *curve = _curves.buffer() + i;
+	if (curve[0] > time) return 0;
+
+	// With monotonic sample times the segment is one more than the number of samples after the first before time.
+#if defined(SPINE_BEZIER_SSE2)
+	SP_UNUSED(frame);
+	__m128 t = _mm_set1_ps(time);
+	__m128 x1 = _mm_shuffle_ps(_mm_loadu_ps(curve + 2), _mm_loadu_ps(curve + 6), _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 x2 = _mm_shuffle_ps(_mm_loadu_ps(curve + 10), _mm_loadu_ps(curve + 14), _MM_SHUFFLE(2, 0, 2, 0));
+	int mask = _mm_movemask_ps(_mm_cmplt_ps(x1, t)) | (_mm_movemask_ps(_mm_cmplt_ps(x2, t)) << 4);
+	mask = mask - ((mask >> 1) & 0x55);
+	mask = (mask & 0x33) + ((mask >> 2) & 0x33);
+	return 1 + ((mask + (mask >> 4)) & 0x0F);
+#elif defined(SPINE_BEZIER_NEON)
+	SP_UNUSED(frame);
+	float32x4_t t = vdupq_n_f32(time);
+	float32x4x2_t samples1 = vld2q_f32(curve + 2), samples2 = vld2q_f32(curve + 10);
+	uint32x4_t before = vaddq_u32(vshrq_n_u32(vcltq_f32(samples1.val[0], t), 31),
+								  vshrq_n_u32(vcltq_f32(samples2.val[0], t), 31));
+	return 1 + vaddvq_u32(before);
+#else
+	// Start at the bucket's segment and walk at most a couple of samples.
+	float time1 = _frames[frame], time2 = _frames[frame + getFrameEntries()];
+	int bucket = (int) ((time - time1) * BEZIER_LOOKUP_SIZE / (time2 - time1));
+	if (bucket < 0) bucket = 0;
+	else if (bucket >= BEZIER_LOOKUP_SIZE) bucket = BEZIER_LOOKUP_SIZE - 1;
+	size_t segment = lookup[bucket];
+	if (segment == 0) segment = 1;
+	while (segment < BEZIER_SEGMENTS - 1 && curve[segment * 2] < time)
+		segment++;
+	return segment;
+#endif
 }
 
 float CurveTimeline::getBezierValue(float time, size_t frameIndex, size_t valueOffset, size_t i) {
-	if (_curves[i] > time) {
+	size_t segment = getBezierSegment(time, frameIndex, i);
+	if (segment == 0) {
 		float x = _frames[frameIndex], y = _frames[frameIndex + valueOffset];
 		return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
 	}
-	size_t n = i + BEZIER_SIZE;
-	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
-		}
+	if (segment < BEZIER_SEGMENTS - 1) {
+		i += segment * 2;
+		float x = _curves[i - 2], y = _curves[i - 1];
+		return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
 	}
+	size_t n = i + BEZIER_SIZE;
 	frameIndex += getFrameEntries();
 	float x = _curves[n - 2], y = _curves[n - 1];
 	return y + (time - x) / (_frames[frameIndex] - x) * (_frames[frameIndex + valueOffset] - y);
@@ -111,13 +203,7 @@ void CurveTimeline1::setFrame(size_t frame, float time, float value) {
 }
 
 float CurveTimeline1::getCurveValue(float time) {
-	int i = (int) _frames.size() - 2;
-	for (int ii = 2; ii <= i; ii += 2) {
-		if (_frames[ii] > time) {
-			i = ii - 2;
-			break;
-		}
-	}
+	int i = Animation::search(_frames, time, CurveTimeline1::ENTRIES);
 
 	int curveType = (int) _curves[i >> 1];
 	switch (curveType) {
@@ -250,3 +336,21 @@ void CurveTimeline2::setFrame(size_t frame, float time, float value1, float valu
 	_frames[frame + CurveTimeline2::VALUE1] = value1;
 	_frames[frame + CurveTimeline2::VALUE2] = value2;
 }
+
+void CurveTimeline2::getBezierValues(float time, size_t frame, size_t i, float &value1, float &value2) {
+	// The y bezier directly follows the x bezier, find both segments before touching either value.
+	size_t segment1 = getBezierSegment(time, frame, i), segment2 = getBezierSegment(time, frame, i + BEZIER_SIZE);
+	const float *frames = _frames.buffer() + frame, *next = frames + CurveTimeline2::ENTRIES;
+	const float *curve1 = _curves.buffer() + i, *curve2 = curve1 + BEZIER_SIZE;
+	float x1, y1, x2, y2;
+
+	if (segment1 == 0) x1 = frames[0], y1 = frames[CurveTimeline2::VALUE1], x2 = curve1[0], y2 = curve1[1];
+	else if (segment1 < BEZIER_SEGMENTS - 1) x1 = curve1[segment1 * 2 - 2], y1 = curve1[segment1 * 2 - 1], x2 = curve1[segment1 * 2], y2 = curve1[segment1 * 2 + 1];
+	else x1 = curve1[BEZIER_SIZE - 2], y1 = curve1[BEZIER_SIZE - 1], x2 = next[0], y2 = next[CurveTimeline2::VALUE1];
+	value1 = y1 + (time - x1) / (x2 - x1) * (y2 - y1);
+
+	if (segment2 == 0) x1 = frames[0], y1 = frames[CurveTimeline2::VALUE2], x2 = curve2[0], y2 = curve2[1];
+	else if (segment2 < BEZIER_SEGMENTS - 1) x1 = curve2[segment2 * 2 - 2], y1 = curve2[segment2 * 2 - 1], x2 = curve2[segment2 * 2], y2 = curve2[segment2 * 2 + 1];
+	else x1 = curve2[BEZIER_SIZE - 2], y1 = curve2[BEZIER_SIZE - 1], x2 = next[0], y2 = next[CurveTimeline2::VALUE2];
+	value2 = y1 + (time - x1) / (x2 - x1) * (y2 - y1);
+}
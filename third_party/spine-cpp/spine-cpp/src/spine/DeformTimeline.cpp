@@ -263,6 +263,7 @@ void DeformTimeline::setBezier(size_t bezier, size_t frame, float value, float t
 	SP_UNUSED(value2);
 	size_t i = getFrameCount() + bezier * DeformTimeline::BEZIER_SIZE;
 	if (value == 0) _curves[frame] = DeformTimeline::BEZIER + i;
+	size_t start = i;
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = cy2 * 0.03 - cy1 * 0.06;
 	float dddx = ((cx1 - cx2) * 3 - time1 + time2) * 0.006, dddy = (cy1 - cy2 + 0.33333333) * 0.018;
 	float ddx = tmpx * 2 + dddx, ddy = tmpy * 2 + dddy;
@@ -278,6 +279,7 @@ void DeformTimeline::setBezier(size_t bezier, size_t frame, float value, float t
 		x += dx;
 		y += dy;
 	}
+	buildBezierLookup(start, time1, time2);
 }
 
 float DeformTimeline::getCurvePercent(float time, int frame) {
@@ -294,16 +296,16 @@ float DeformTimeline::getCurvePercent(float time, int frame) {
 		}
 	}
 	i -= DeformTimeline::BEZIER;
-	if (_curves[i] > time) {
+	size_t segment = getBezierSegment(time, frame, i);
+	if (segment == 0) {
 		float x = _frames[frame];
 		return _curves[i + 1] * (time - x) / (_curves[i] - x);
 	}
 	int n = i + DeformTimeline::BEZIER_SIZE;
-	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
-		}
+	if (segment < (size_t) DeformTimeline::BEZIER_SEGMENTS - 1) {
+		i += (int) segment * 2;
+		float x = _curves[i - 2], y = _curves[i - 1];
+		return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
 	}
 	float x = _curves[n - 2], y = _curves[n - 1];
 	return y + (1 - y) * (time - x) / (_frames[frame + getFrameEntries()] - x);
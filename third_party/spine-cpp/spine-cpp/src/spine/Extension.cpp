@@ -31,6 +31,22 @@
 #include <spine/SpineString.h>
 
 #include <assert.h>
+#include <limits.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace spine;
 
@@ -123,5 +139,63 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 #endif
 }
 
+const char *DefaultSpineExtension::_mapFile(const String &path, int *length) {
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.buffer(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || size.QuadPart > INT_MAX) {
+		CloseHandle(file);
+		return NULL;
+	}
+
+	// The view keeps the file and the mapping object alive until it is unmapped
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping) return NULL;
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data) return NULL;
+
+	*length = (int) size.QuadPart;
+	return (const char *) data;
+#elif !defined(__EMSCRIPTEN__)
+	int file = open(path.buffer(), O_RDONLY);
+	if (file < 0) return NULL;
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0 || info.st_size > INT_MAX) {
+		close(file);
+		return NULL;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	void *data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return NULL;
+	posix_madvise(data, (size_t) info.st_size, POSIX_MADV_SEQUENTIAL);
+
+	*length = (int) info.st_size;
+	return (const char *) data;
+#else
+	SP_UNUSED(path);
+	SP_UNUSED(length);
+	return NULL;
+#endif
+}
+
+void DefaultSpineExtension::_unmapFile(const char *data, int length) {
+	if (!data) return;
+#if defined(_WIN32)
+	SP_UNUSED(length);
+	UnmapViewOfFile(data);
+#elif !defined(__EMSCRIPTEN__)
+	munmap((void *) data, (size_t) length);
+#else
+	SP_UNUSED(length);
+#endif
+}
+
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
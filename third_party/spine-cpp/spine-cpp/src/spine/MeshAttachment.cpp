@@ -167,6 +167,7 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 	if (inValue != NULL) {
 		_bones.clearAndAddAll(inValue->_bones);
 		_vertices.clearAndAddAll(inValue->_vertices);
+		prepareWeights();
 		_worldVerticesLength = inValue->_worldVerticesLength;
 		_regionUVs.clearAndAddAll(inValue->_regionUVs);
 		_triangles.clearAndAddAll(inValue->_triangles);
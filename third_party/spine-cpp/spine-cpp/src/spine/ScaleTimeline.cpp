@@ -93,9 +93,7 @@ void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 			break;
 		}
 		default: {
-			x = getBezierValue(time, i, CurveTimeline2::VALUE1, curveType - CurveTimeline2::BEZIER);
-			y = getBezierValue(time, i, CurveTimeline2::VALUE2,
-							   curveType + CurveTimeline2::BEZIER_SIZE - CurveTimeline2::BEZIER);
+			getBezierValues(time, i, curveType - CurveTimeline2::BEZIER, x, y);
 		}
 	}
 	x *= bone->_data._scaleX;
@@ -95,9 +95,7 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 			break;
 		}
 		default: {
-			x = getBezierValue(time, i, CurveTimeline2::VALUE1, curveType - CurveTimeline2::BEZIER);
-			y = getBezierValue(time, i, CurveTimeline2::VALUE2,
-							   curveType + CurveTimeline2::BEZIER_SIZE - CurveTimeline2::BEZIER);
+			getBezierValues(time, i, curveType - CurveTimeline2::BEZIER, x, y);
 		}
 	}
 
@@ -60,9 +60,9 @@ using namespace spine;
 Skeleton::Skeleton(SkeletonData *skeletonData)
 	: _data(skeletonData), _skin(NULL), _color(1, 1, 1, 1), _scaleX(1),
 	  _scaleY(1), _x(0), _y(0), _time(0) {
-	_bones.ensureCapacity(_data->getBones().size());
-	for (size_t i = 0; i < _data->getBones().size(); ++i) {
-		BoneData *data = _data->getBones()[i];
+	_bones.ensureCapacity(_data->_bones.size());
+	for (size_t i = 0; i < _data->_bones.size(); ++i) {
+		BoneData *data = _data->_bones[i];
 
 		Bone *bone;
 		if (data->getParent() == NULL) {
@@ -76,10 +76,10 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 		_bones.add(bone);
 	}
 
-	_slots.ensureCapacity(_data->getSlots().size());
-	_drawOrder.ensureCapacity(_data->getSlots().size());
-	for (size_t i = 0; i < _data->getSlots().size(); ++i) {
-		SlotData *data = _data->getSlots()[i];
+	_slots.ensureCapacity(_data->_slots.size());
+	_drawOrder.ensureCapacity(_data->_slots.size());
+	for (size_t i = 0; i < _data->_slots.size(); ++i) {
+		SlotData *data = _data->_slots[i];
 
 		Bone *bone = _bones[data->getBoneData().getIndex()];
 		Slot *slot = new (__FILE__, __LINE__) Slot(*data, *bone);
@@ -88,9 +88,9 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 		_drawOrder.add(slot);
 	}
 
-	_ikConstraints.ensureCapacity(_data->getIkConstraints().size());
-	for (size_t i = 0; i < _data->getIkConstraints().size(); ++i) {
-		IkConstraintData *data = _data->getIkConstraints()[i];
+	_ikConstraints.ensureCapacity(_data->_ikConstraints.size());
+	for (size_t i = 0; i < _data->_ikConstraints.size(); ++i) {
+		IkConstraintData *data = _data->_ikConstraints[i];
 
 		IkConstraint *constraint =
 				new (__FILE__, __LINE__) IkConstraint(*data, *this);
@@ -98,9 +98,9 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 		_ikConstraints.add(constraint);
 	}
 
-	_transformConstraints.ensureCapacity(_data->getTransformConstraints().size());
-	for (size_t i = 0; i < _data->getTransformConstraints().size(); ++i) {
-		TransformConstraintData *data = _data->getTransformConstraints()[i];
+	_transformConstraints.ensureCapacity(_data->_transformConstraints.size());
+	for (size_t i = 0; i < _data->_transformConstraints.size(); ++i) {
+		TransformConstraintData *data = _data->_transformConstraints[i];
 
 		TransformConstraint *constraint =
 				new (__FILE__, __LINE__) TransformConstraint(*data, *this);
@@ -108,9 +108,9 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 		_transformConstraints.add(constraint);
 	}
 
-	_pathConstraints.ensureCapacity(_data->getPathConstraints().size());
-	for (size_t i = 0; i < _data->getPathConstraints().size(); ++i) {
-		PathConstraintData *data = _data->getPathConstraints()[i];
+	_pathConstraints.ensureCapacity(_data->_pathConstraints.size());
+	for (size_t i = 0; i < _data->_pathConstraints.size(); ++i) {
+		PathConstraintData *data = _data->_pathConstraints[i];
 
 		PathConstraint *constraint =
 				new (__FILE__, __LINE__) PathConstraint(*data, *this);
@@ -118,9 +118,9 @@ Skeleton::Skeleton(SkeletonData *skeletonData)
 		_pathConstraints.add(constraint);
 	}
 
-	_physicsConstraints.ensureCapacity(_data->getPhysicsConstraints().size());
-	for (size_t i = 0; i < _data->getPhysicsConstraints().size(); ++i) {
-		PhysicsConstraintData *data = _data->getPhysicsConstraints()[i];
+	_physicsConstraints.ensureCapacity(_data->_physicsConstraints.size());
+	for (size_t i = 0; i < _data->_physicsConstraints.size(); ++i) {
+		PhysicsConstraintData *data = _data->_physicsConstraints[i];
 
 		PhysicsConstraint *constraint =
 				new (__FILE__, __LINE__) PhysicsConstraint(*data, *this);
@@ -319,11 +319,14 @@ void Skeleton::setSlotsToSetupPose() {
 }
 
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	// Bones and slots are created in data order, so the data's name index applies.
+	int index = _data->findBoneIndex(boneName);
+	return index == -1 ? NULL : _bones[index];
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	int index = _data->findSlotIndex(slotName);
+	return index == -1 ? NULL : _slots[index];
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -74,18 +74,78 @@
 #include <spine/SequenceTimeline.h>
 #include <spine/Version.h>
 
+#include <string.h>
+
 using namespace spine;
 
+/// Loads a big endian 32 bit value from a possibly unaligned position.
+static inline uint32_t readBigEndian32(const unsigned char *bytes) {
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return value;
+#elif defined(_MSC_VER)
+	return _byteswap_ulong(value);
+#else
+	return __builtin_bswap32(value);
+#endif
+}
+
+namespace spine {
+	/// Keeps the animation section of a .skel file and decodes single animations when they are first used.
+	class BinaryAnimationSource : public AnimationSource {
+		friend class SkeletonBinary;
+
+	public:
+		BinaryAnimationSource(SkeletonData *skeletonData, float scale) : _skeletonData(skeletonData),
+																		 _binary((Atlas *) NULL),
+																		 _buffer(NULL),
+																		 _length(0),
+																		 _mapped(false),
+																		 _start(NULL) {
+			_binary.setScale(scale);
+		}
+
+		virtual ~BinaryAnimationSource() {
+			if (_mapped)
+				SpineExtension::unmapFile((const char *) _buffer, _length);
+			else if (_buffer)
+				SpineExtension::free(_buffer, __FILE__, __LINE__);
+		}
+
+		virtual bool loadTimelines(Animation &animation, int index, Vector<Timeline *> &timelines) {
+			SP_UNUSED(animation);
+			SkeletonBinary::DataInput input;
+			input.cursor = _start + _offsets[index];
+			input.end = _buffer + _length;
+			if (_binary.readTimelines(&input, _skeletonData, timelines)) return true;
+			ContainerUtil::cleanUpVectorOfPointers(timelines);
+			return false;
+		}
+
+	private:
+		SkeletonData *_skeletonData;
+		SkeletonBinary _binary;
+		const unsigned char *_buffer; // Owned: allocated by SpineExtension or mapped if _mapped.
+		int _length;
+		bool _mapped;
+		const unsigned char *_start;  // Start of the animation section in _buffer.
+		Vector<int> _offsets;         // Offset of each animation's timelines from _start.
+	};
+}
+
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _ownsLoader(true),
+													_lazyAnimations(false) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
-																					  _ownsLoader(ownsLoader) {
+																					  _ownsLoader(ownsLoader),
+																					  _lazyAnimations(false) {
 	assert(_attachmentLoader != NULL);
 }
 
@@ -97,6 +157,10 @@ SkeletonBinary::~SkeletonBinary() {
 }
 
 SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length) {
+	return readSkeletonData(binary, length, BufferBorrowed);
+}
+
+SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length, BufferOwnership ownership) {
 	bool nonessential;
 	SkeletonData *skeletonData;
 
@@ -190,7 +254,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 			slotData->getDarkColor().set(r / 255.0f, g / 255.0f, b / 255.0f, 1);
 			slotData->setHasDarkColor(true);
 		}
-		slotData->_attachmentName = readStringRef(input, skeletonData);
+		slotData->setAttachmentName(readStringRef(input, skeletonData));
 		slotData->_blendMode = static_cast<BlendMode>(readVarint(input, true));
 		if (nonessential) {
 			slotData->_visible = readBoolean(input);
@@ -384,9 +448,24 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
+	BinaryAnimationSource *source = NULL;
+	if (_lazyAnimations && animationsCount > 0) {
+		source = new (__FILE__, __LINE__) BinaryAnimationSource(skeletonData, _scale);
+		skeletonData->_animationSource = source;
+	}
+	const unsigned char *animationsStart = input->cursor;
 	for (int i = 0; i < animationsCount; ++i) {
 		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
+		Animation *animation = NULL;
+		if (source) {
+			// Only the duration is needed now, the timelines are decoded by Animation::load()
+			source->_offsets.add((int) (input->cursor - animationsStart));
+			float duration;
+			if (skipTimelines(input, skeletonData, duration))
+				animation = new (__FILE__, __LINE__) Animation(name, duration, source, i);
+		} else {
+			animation = readAnimation(name, input, skeletonData);
+		}
 		if (!animation) {
 			delete input;
 			delete skeletonData;
@@ -395,20 +474,51 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		skeletonData->_animations[i] = animation;
 	}
 
+	if (source) {
+		if (ownership == BufferBorrowed) {
+			// The caller keeps its buffer, copy the animation section
+			int sectionLength = (int) (input->end - animationsStart);
+			unsigned char *section = SpineExtension::alloc<unsigned char>(sectionLength, __FILE__, __LINE__);
+			memcpy(section, animationsStart, sectionLength);
+			source->_buffer = section;
+			source->_length = sectionLength;
+			source->_start = section;
+		} else {
+			source->_buffer = binary;
+			source->_length = length;
+			source->_mapped = ownership == BufferMapped;
+			source->_start = animationsStart;
+		}
+	}
+
 	delete input;
 	return skeletonData;
 }
 
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
-	int length;
+	int length = 0;
 	SkeletonData *skeletonData;
-	const char *binary = SpineExtension::readFile(path.buffer(), &length);
+
+	// Decode straight from the mapped file; fall back to reading it into memory if mapping is not available
+	bool mapped = true;
+	const char *binary = SpineExtension::mapFile(path, &length);
+	if (!binary) {
+		mapped = false;
+		length = 0;
+		binary = SpineExtension::readFile(path, &length);
+	}
 	if (length == 0 || !binary) {
+		if (binary) SpineExtension::free(binary, __FILE__, __LINE__);
 		setError("Unable to read skeleton file: ", path.buffer());
 		return NULL;
 	}
-	skeletonData = readSkeletonData((unsigned char *) binary, length);
-	SpineExtension::free(binary, __FILE__, __LINE__);
+	skeletonData = readSkeletonData((unsigned char *) binary, length, mapped ? BufferMapped : BufferAllocated);
+	// Lazily loaded animations keep decoding from the buffer, it is released with the skeleton data
+	if (skeletonData && skeletonData->_animationSource) return skeletonData;
+	if (mapped)
+		SpineExtension::unmapFile(binary, length);
+	else
+		SpineExtension::free(binary, __FILE__, __LINE__);
 	return skeletonData;
 }
 
@@ -459,13 +569,8 @@ bool SkeletonBinary::readBoolean(DataInput *input) {
 }
 
 int SkeletonBinary::readInt(DataInput *input) {
-	int result = readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
+	int result = (int) readBigEndian32(input->cursor);
+	input->cursor += 4;
 	return result;
 }
 
@@ -610,6 +715,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			}
 			int verticesLength = readVertices(input, box->getVertices(), box->getBones(), (flags & 16) != 0);
 			box->setWorldVerticesLength(verticesLength);
+			box->prepareWeights();
 			if (nonessential) {
 				readColor(input, box->getColor());
 			}
@@ -650,6 +756,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			mesh->_color.set(color);
 			mesh->_bones.addAll(bones);
 			mesh->_vertices.addAll(vertices);
+			mesh->prepareWeights();
 			mesh->setWorldVerticesLength(verticesLength);
 			mesh->_triangles.addAll(triangles);
 			mesh->_regionUVs.addAll(uvs);
@@ -706,6 +813,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			path->_constantSpeed = (flags & 32) != 0;
 			int verticesLength = readVertices(input, path->getVertices(), path->getBones(), (flags & 64) != 0);
 			path->setWorldVerticesLength(verticesLength);
+			path->prepareWeights();
 			int lengthsLength = verticesLength / 6;
 			path->_lengths.setSize(lengthsLength, 0);
 			for (int i = 0; i < lengthsLength; ++i) {
@@ -742,6 +850,7 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			}
 			int verticesLength = readVertices(input, clip->getVertices(), clip->getBones(), (flags & 16) != 0);
 			clip->setWorldVerticesLength(verticesLength);
+			clip->prepareWeights();
 			clip->_endSlot = skeletonData->_slots[endSlotIndex];
 			if (nonessential) {
 				readColor(input, clip->getColor());
@@ -779,22 +888,27 @@ int SkeletonBinary::readVertices(DataInput *input, Vector<float> &vertices, Vect
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
 	array.setSize(n, 0);
 
-	int i;
-	if (scale == 1) {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input);
-		}
-	} else {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input) * scale;
+	// Byte swap the whole run in one pass, the input has no alignment guarantees
+	float *values = array.buffer();
+	const unsigned char *cursor = input->cursor;
+	for (int i = 0; i < n; ++i, cursor += 4) {
+		uint32_t bits = readBigEndian32(cursor);
+		memcpy(&values[i], &bits, sizeof(float));
+	}
+	input->cursor = cursor;
+
+	if (scale != 1) {
+		for (int i = 0; i < n; ++i) {
+			values[i] *= scale;
 		}
 	}
 }
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array, int n) {
 	array.setSize(n, 0);
+	unsigned short *values = array.buffer();
 	for (int i = 0; i < n; ++i) {
-		array[i] = (short) readVarint(input, true);
+		values[i] = (short) readVarint(input, true);
 	}
 }
 
@@ -856,6 +970,16 @@ void SkeletonBinary::readTimeline2(DataInput *input, Vector<Timeline *> &timelin
 
 Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
 	Vector<Timeline *> timelines;
+	if (!readTimelines(input, skeletonData, timelines)) return NULL;
+
+	float duration = 0;
+	for (int i = 0, n = (int) timelines.size(); i < n; i++) {
+		duration = MathUtil::max(duration, (timelines[i])->getDuration());
+	}
+	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
+}
+
+bool SkeletonBinary::readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines) {
 	float scale = _scale;
 	int numTimelines = readVarint(input, true);
 	SP_UNUSED(numTimelines);
@@ -1073,7 +1197,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -1144,7 +1268,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -1333,7 +1457,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Attachment not found: ", attachmentName);
-					return NULL;
+					return false;
 				}
 				unsigned int timelineType = readByte(input);
 				int frameCount = readVarint(input, true);
@@ -1482,9 +1606,214 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		timelines.add(timeline);
 	}
 
-	float duration = 0;
-	for (int i = 0, n = (int) timelines.size(); i < n; i++) {
-		duration = MathUtil::max(duration, (timelines[i])->getDuration());
+	return true;
+}
+
+float SkeletonBinary::skipCurveFrames(DataInput *input, int frameCount, int valueBytes, int curveCount) {
+	float time = readFloat(input);
+	input->cursor += valueBytes;
+	for (int frame = 1; frame < frameCount; frame++) {
+		time = readFloat(input);
+		input->cursor += valueBytes;
+		if (readSByte(input) == CURVE_BEZIER) input->cursor += curveCount * 16;
 	}
-	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	return time;
+}
+
+bool SkeletonBinary::skipTimelines(DataInput *input, SkeletonData *skeletonData, float &duration) {
+	// Mirrors readTimelines() without creating timelines, the duration is the time of the last frame of any timeline.
+	duration = 0;
+	readVarint(input, true);
+
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int slotIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			float time = 0;
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					time = readFloat(input);
+					readVarint(input, true);
+				}
+			} else {
+				readVarint(input, true);
+				switch (timelineType) {
+					case SLOT_RGBA:
+						time = skipCurveFrames(input, frameCount, 4, 4);
+						break;
+					case SLOT_RGB:
+						time = skipCurveFrames(input, frameCount, 3, 3);
+						break;
+					case SLOT_RGBA2:
+						time = skipCurveFrames(input, frameCount, 7, 7);
+						break;
+					case SLOT_RGB2:
+						time = skipCurveFrames(input, frameCount, 6, 6);
+						break;
+					case SLOT_ALPHA:
+						time = skipCurveFrames(input, frameCount, 1, 1);
+						break;
+					default:
+						setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+						return false;
+				}
+			}
+			duration = MathUtil::max(duration, time);
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int boneIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			float time = 0;
+			if (timelineType == BONE_INHERIT) {
+				for (int frame = 0; frame < frameCount; frame++) {
+					time = readFloat(input);
+					readByte(input);
+				}
+			} else {
+				readVarint(input, true);
+				switch (timelineType) {
+					case BONE_ROTATE:
+					case BONE_TRANSLATEX:
+					case BONE_TRANSLATEY:
+					case BONE_SCALEX:
+					case BONE_SCALEY:
+					case BONE_SHEARX:
+					case BONE_SHEARY:
+						time = skipCurveFrames(input, frameCount, 4, 1);
+						break;
+					case BONE_TRANSLATE:
+					case BONE_SCALE:
+					case BONE_SHEAR:
+						time = skipCurveFrames(input, frameCount, 8, 2);
+						break;
+					default:
+						setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+						return false;
+				}
+			}
+			duration = MathUtil::max(duration, time);
+		}
+	}
+
+	// IK timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		float time = 0;
+		for (int frame = 0; frame < frameCount; frame++) {
+			int flags = readByte(input);
+			time = readFloat(input);
+			if ((flags & 1) != 0 && (flags & 2) != 0) input->cursor += 4;
+			if ((flags & 4) != 0) input->cursor += 4;
+			if (frame > 0 && (flags & 64) == 0 && (flags & 128) != 0) input->cursor += 2 * 16;
+		}
+		duration = MathUtil::max(duration, time);
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 24, 6));
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			if (type == PATH_MIX)
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 12, 3));
+			else
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 4, 1));
+		}
+	}
+
+	// Physics timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; i++) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			float time = 0;
+			if (type == PHYSICS_RESET) {
+				for (int frame = 0; frame < frameCount; frame++)
+					time = readFloat(input);
+			} else {
+				readVarint(input, true);
+				time = skipCurveFrames(input, frameCount, 4, 1);
+			}
+			duration = MathUtil::max(duration, time);
+		}
+	}
+
+	// Attachment timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				readVarint(input, true);
+				unsigned int timelineType = readByte(input);
+				int frameCount = readVarint(input, true);
+				float time = 0;
+				switch (timelineType) {
+					case ATTACHMENT_DEFORM: {
+						readVarint(input, true);
+						time = readFloat(input);
+						for (int frame = 1;; frame++) {
+							int end = readVarint(input, true);
+							if (end != 0) {
+								readVarint(input, true);
+								input->cursor += end * 4;
+							}
+							if (frame >= frameCount) break;
+							time = readFloat(input);
+							if (readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+						}
+						break;
+					}
+					case ATTACHMENT_SEQUENCE:
+						for (int frame = 0; frame < frameCount; frame++) {
+							time = readFloat(input);
+							input->cursor += 8;
+						}
+						break;
+				}
+				duration = MathUtil::max(duration, time);
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		input->cursor += 4;
+		int length = readVarint(input, true);
+		if (length > 0) input->cursor += length - 1;
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
+	}
+	return true;
 }
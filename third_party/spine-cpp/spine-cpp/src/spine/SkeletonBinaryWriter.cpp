@@ -0,0 +1,1118 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonBinaryWriter.h>
+
+#include <spine/Animation.h>
+#include <spine/AttachmentTimeline.h>
+#include <spine/AttachmentType.h>
+#include <spine/BoneData.h>
+#include <spine/BoundingBoxAttachment.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/ColorTimeline.h>
+#include <spine/CurveTimeline.h>
+#include <spine/DeformTimeline.h>
+#include <spine/DrawOrderTimeline.h>
+#include <spine/Event.h>
+#include <spine/EventData.h>
+#include <spine/EventTimeline.h>
+#include <spine/IkConstraintData.h>
+#include <spine/IkConstraintTimeline.h>
+#include <spine/InheritTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/PathAttachment.h>
+#include <spine/PathConstraintData.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintPositionTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
+#include <spine/PhysicsConstraintData.h>
+#include <spine/PhysicsConstraintTimeline.h>
+#include <spine/PointAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/RotateTimeline.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/Sequence.h>
+#include <spine/SequenceTimeline.h>
+#include <spine/ShearTimeline.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraintData.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TranslateTimeline.h>
+
+#include <string.h>
+
+using namespace spine;
+
+// Layout of CurveTimeline::getCurves(): the curve type per frame, then BEZIER_SIZE samples per bezier
+static const int CURVE_LINEAR = 0;
+static const int CURVE_STEPPED = 1;
+static const int CURVE_BEZIER = 2;
+static const int BEZIER_SIZE = 18;
+
+/// Recovers the control points of a bezier from the 9 points CurveTimeline::setBezier() samples at t = 0.1 ... 0.9,
+/// as the least squares solution of the cubic bezier equation for the two inner control points.
+static void bezierControlPoints(const float *samples, int axis, float start, float end, float &control1,
+								float &control2) {
+	double a11 = 0, a12 = 0, a22 = 0, b1 = 0, b2 = 0;
+	for (int k = 1; k <= 9; k++) {
+		double t = k * 0.1, u = 1 - t;
+		double w1 = 3 * u * u * t, w2 = 3 * u * t * t;
+		double rest = samples[(k - 1) * 2 + axis] - u * u * u * start - t * t * t * end;
+		a11 += w1 * w1;
+		a12 += w1 * w2;
+		a22 += w2 * w2;
+		b1 += w1 * rest;
+		b2 += w2 * rest;
+	}
+	double det = a11 * a22 - a12 * a12;
+	control1 = (float) ((b1 * a22 - b2 * a12) / det);
+	control2 = (float) ((a11 * b2 - a12 * b1) / det);
+}
+
+static int colorByte(float value) {
+	return (int) (MathUtil::clamp(value, 0, 1) * 255 + 0.5f);
+}
+
+SkeletonBinaryWriter::SkeletonBinaryWriter() : _skeletonData(NULL), _output(NULL), _defaultSkinSkipped(false), _error() {
+}
+
+SkeletonBinaryWriter::~SkeletonBinaryWriter() {
+}
+
+bool SkeletonBinaryWriter::writeSkeletonData(SkeletonData &skeletonData, Vector<unsigned char> &output) {
+	_skeletonData = &skeletonData;
+	_strings.clear();
+	_stringIndex.clear();
+	_error = "";
+
+	// The string table precedes the bones but is only known after everything else is written
+	Vector<unsigned char> body;
+	_output = &body;
+
+	/* Bones. */
+	Vector<BoneData *> &bones = skeletonData.getBones();
+	writeVarint((int) bones.size(), true);
+	for (size_t i = 0; i < bones.size(); i++) {
+		BoneData *data = bones[i];
+		writeString(data->getName());
+		if (i > 0) writeVarint(data->getParent()->getIndex(), true);
+		writeFloat(data->getRotation());
+		writeFloat(data->getX());
+		writeFloat(data->getY());
+		writeFloat(data->getScaleX());
+		writeFloat(data->getScaleY());
+		writeFloat(data->getShearX());
+		writeFloat(data->getShearY());
+		writeFloat(data->getLength());
+		writeVarint(data->getInherit(), true);
+		writeBoolean(data->isSkinRequired());
+		writeColor(data->getColor());
+		writeString(data->getIcon());
+		writeBoolean(data->isVisible());
+	}
+
+	/* Slots. */
+	Vector<SlotData *> &slots = skeletonData.getSlots();
+	writeVarint((int) slots.size(), true);
+	for (size_t i = 0; i < slots.size(); i++) {
+		SlotData *data = slots[i];
+		writeString(data->getName());
+		writeVarint(data->getBoneData().getIndex(), true);
+		writeColor(data->getColor());
+		// ARGB, all bits set means no dark color
+		if (data->hasDarkColor()) {
+			Color &dark = data->getDarkColor();
+			writeByte(0);
+			writeByte(colorByte(dark.r));
+			writeByte(colorByte(dark.g));
+			writeByte(colorByte(dark.b));
+		} else {
+			writeInt(-1);
+		}
+		writeStringRef(data->getAttachmentName());
+		writeVarint(data->getBlendMode(), true);
+		writeBoolean(data->isVisible());
+	}
+
+	/* IK constraints. */
+	Vector<IkConstraintData *> &ikConstraints = skeletonData.getIkConstraints();
+	writeVarint((int) ikConstraints.size(), true);
+	for (size_t i = 0; i < ikConstraints.size(); i++) {
+		IkConstraintData *data = ikConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ii++)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		int flags = 32 | 64 | 128;
+		if (data->isSkinRequired()) flags |= 1;
+		if (data->getBendDirection() == 1) flags |= 2;
+		if (data->getCompress()) flags |= 4;
+		if (data->getStretch()) flags |= 8;
+		if (data->getUniform()) flags |= 16;
+		writeByte(flags);
+		writeFloat(data->getMix());
+		writeFloat(data->getSoftness());
+	}
+
+	/* Transform constraints. */
+	Vector<TransformConstraintData *> &transformConstraints = skeletonData.getTransformConstraints();
+	writeVarint((int) transformConstraints.size(), true);
+	for (size_t i = 0; i < transformConstraints.size(); i++) {
+		TransformConstraintData *data = transformConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ii++)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		int flags = 8 | 16 | 32 | 64 | 128;
+		if (data->isSkinRequired()) flags |= 1;
+		if (data->isLocal()) flags |= 2;
+		if (data->isRelative()) flags |= 4;
+		writeByte(flags);
+		writeFloat(data->getOffsetRotation());
+		writeFloat(data->getOffsetX());
+		writeFloat(data->getOffsetY());
+		writeFloat(data->getOffsetScaleX());
+		writeFloat(data->getOffsetScaleY());
+		writeByte(127);
+		writeFloat(data->getOffsetShearY());
+		writeFloat(data->getMixRotate());
+		writeFloat(data->getMixX());
+		writeFloat(data->getMixY());
+		writeFloat(data->getMixScaleX());
+		writeFloat(data->getMixScaleY());
+		writeFloat(data->getMixShearY());
+	}
+
+	/* Path constraints. */
+	Vector<PathConstraintData *> &pathConstraints = skeletonData.getPathConstraints();
+	writeVarint((int) pathConstraints.size(), true);
+	for (size_t i = 0; i < pathConstraints.size(); i++) {
+		PathConstraintData *data = pathConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeBoolean(data->isSkinRequired());
+		writeVarint((int) data->getBones().size(), true);
+		for (size_t ii = 0; ii < data->getBones().size(); ii++)
+			writeVarint(data->getBones()[ii]->getIndex(), true);
+		writeVarint(data->getTarget()->getIndex(), true);
+		writeByte(data->getPositionMode() | (data->getSpacingMode() << 1) | (data->getRotateMode() << 3) | 128);
+		writeFloat(data->getOffsetRotation());
+		writeFloat(data->getPosition());
+		writeFloat(data->getSpacing());
+		writeFloat(data->getMixRotate());
+		writeFloat(data->getMixX());
+		writeFloat(data->getMixY());
+	}
+
+	/* Physics constraints. */
+	Vector<PhysicsConstraintData *> &physicsConstraints = skeletonData.getPhysicsConstraints();
+	writeVarint((int) physicsConstraints.size(), true);
+	for (size_t i = 0; i < physicsConstraints.size(); i++) {
+		PhysicsConstraintData *data = physicsConstraints[i];
+		writeString(data->getName());
+		writeVarint((int) data->getOrder(), true);
+		writeVarint(data->getBone()->getIndex(), true);
+		writeByte((data->isSkinRequired() ? 1 : 0) | 2 | 4 | 8 | 16 | 32 | 64 | 128);
+		writeFloat(data->getX());
+		writeFloat(data->getY());
+		writeFloat(data->getRotate());
+		writeFloat(data->getScaleX());
+		writeFloat(data->getShearX());
+		writeFloat(data->getLimit());
+		writeByte((int) (1 / data->getStep() + 0.5f));
+		writeFloat(data->getInertia());
+		writeFloat(data->getStrength());
+		writeFloat(data->getDamping());
+		writeFloat(data->getMassInverse());
+		writeFloat(data->getWind());
+		writeFloat(data->getGravity());
+		int flags = 128;
+		if (data->isInertiaGlobal()) flags |= 1;
+		if (data->isStrengthGlobal()) flags |= 2;
+		if (data->isDampingGlobal()) flags |= 4;
+		if (data->isMassGlobal()) flags |= 8;
+		if (data->isWindGlobal()) flags |= 16;
+		if (data->isGravityGlobal()) flags |= 32;
+		if (data->isMixGlobal()) flags |= 64;
+		writeByte(flags);
+		writeFloat(data->getMix());
+	}
+
+	/* Skins. The reader drops a default skin without attachments, which shifts the other skin indices. */
+	Skin *defaultSkin = skeletonData.getDefaultSkin();
+	Vector<Skin *> &skins = skeletonData.getSkins();
+	_defaultSkinSkipped = defaultSkin && !defaultSkin->getAttachments().hasNext();
+	if (defaultSkin && !_defaultSkinSkipped) {
+		if (!writeSkin(*defaultSkin, true)) return false;
+	} else {
+		writeVarint(0, true);
+	}
+	writeVarint((int) skins.size() - (defaultSkin ? 1 : 0), true);
+	for (size_t i = 0; i < skins.size(); i++) {
+		if (skins[i] == defaultSkin) continue;
+		if (!writeSkin(*skins[i], false)) return false;
+	}
+
+	/* Events. */
+	Vector<EventData *> &events = skeletonData.getEvents();
+	writeVarint((int) events.size(), true);
+	for (size_t i = 0; i < events.size(); i++) {
+		EventData *data = events[i];
+		writeString(data->getName());
+		writeVarint(data->getIntValue(), false);
+		writeFloat(data->getFloatValue());
+		writeString(data->getStringValue());
+		writeString(data->getAudioPath());
+		if (!data->getAudioPath().isEmpty()) {
+			writeFloat(data->getVolume());
+			writeFloat(data->getBalance());
+		}
+	}
+
+	/* Animations. */
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	writeVarint((int) animations.size(), true);
+	for (size_t i = 0; i < animations.size(); i++) {
+		if (!animations[i]->load()) {
+			setError("Animation could not be loaded: ", animations[i]->getName().buffer());
+			return false;
+		}
+		writeString(animations[i]->getName());
+		if (!writeAnimation(*animations[i])) return false;
+	}
+
+	/* Header and string table. */
+	output.clear();
+	_output = &output;
+	writeInt(0);
+	writeInt(0);
+	writeString(skeletonData.getVersion());
+	writeFloat(skeletonData.getX());
+	writeFloat(skeletonData.getY());
+	writeFloat(skeletonData.getWidth());
+	writeFloat(skeletonData.getHeight());
+	writeFloat(skeletonData.getReferenceScale());
+	writeBoolean(true);
+	writeFloat(skeletonData.getFps());
+	writeString(skeletonData.getImagesPath());
+	writeString(skeletonData.getAudioPath());
+	writeVarint((int) _strings.size(), true);
+	for (size_t i = 0; i < _strings.size(); i++)
+		writeString(_strings[i]);
+
+	size_t headerLength = output.size();
+	output.setSize(headerLength + body.size(), 0);
+	if (body.size() > 0) memcpy(output.buffer() + headerLength, body.buffer(), body.size());
+	_output = NULL;
+	_skeletonData = NULL;
+	return true;
+}
+
+void SkeletonBinaryWriter::setError(const char *value1, const char *value2) {
+	_error = String(value1);
+	_error.append(value2);
+}
+
+void SkeletonBinaryWriter::writeByte(int value) {
+	_output->add((unsigned char) value);
+}
+
+void SkeletonBinaryWriter::writeBoolean(bool value) {
+	writeByte(value ? 1 : 0);
+}
+
+void SkeletonBinaryWriter::writeInt(int value) {
+	unsigned int bits = (unsigned int) value;
+	writeByte((bits >> 24) & 0xff);
+	writeByte((bits >> 16) & 0xff);
+	writeByte((bits >> 8) & 0xff);
+	writeByte(bits & 0xff);
+}
+
+void SkeletonBinaryWriter::writeFloat(float value) {
+	int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	writeInt(bits);
+}
+
+void SkeletonBinaryWriter::writeVarint(int value, bool optimizePositive) {
+	unsigned int bits = optimizePositive ? (unsigned int) value
+										 : ((unsigned int) value << 1) ^ (unsigned int) (value >> 31);
+	while (bits > 0x7f) {
+		writeByte((bits & 0x7f) | 0x80);
+		bits >>= 7;
+	}
+	writeByte(bits);
+}
+
+void SkeletonBinaryWriter::writeString(const String &value) {
+	// Length plus one, 0 reads back as NULL
+	if (value.isEmpty()) {
+		writeVarint(0, true);
+		return;
+	}
+	writeVarint((int) value.length() + 1, true);
+	for (size_t i = 0; i < value.length(); i++)
+		writeByte(value.buffer()[i]);
+}
+
+void SkeletonBinaryWriter::writeStringRef(const String &value) {
+	if (value.isEmpty()) {
+		writeVarint(0, true);
+		return;
+	}
+	if (!_stringIndex.containsKey(value)) {
+		_strings.add(value);
+		_stringIndex.put(value, (int) _strings.size());
+	}
+	writeVarint(_stringIndex[value], true);
+}
+
+void SkeletonBinaryWriter::writeColor(const Color &color) {
+	writeByte(colorByte(color.r));
+	writeByte(colorByte(color.g));
+	writeByte(colorByte(color.b));
+	writeByte(colorByte(color.a));
+}
+
+int SkeletonBinaryWriter::skinIndex(Skin *skin) {
+	int index = _skeletonData->getSkins().indexOf(skin);
+	return _defaultSkinSkipped && index > 0 ? index - 1 : index;
+}
+
+bool SkeletonBinaryWriter::findAttachment(Attachment *attachment, int slotIndex, int &skinIndex, String &name) {
+	Vector<Skin *> &skins = _skeletonData->getSkins();
+	for (size_t i = 0; i < skins.size(); i++) {
+		Skin::AttachmentMap::Entries entries = skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (entry._attachment == attachment && (int) entry._slotIndex == slotIndex) {
+				skinIndex = this->skinIndex(skins[i]);
+				name = entry._name;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool SkeletonBinaryWriter::writeSkin(Skin &skin, bool defaultSkin) {
+	if (!defaultSkin) {
+		writeString(skin.getName());
+		writeColor(skin.getColor());
+
+		writeVarint((int) skin.getBones().size(), true);
+		for (size_t i = 0; i < skin.getBones().size(); i++)
+			writeVarint(skin.getBones()[i]->getIndex(), true);
+
+		// Constraints are written by type: IK, transform, path, physics
+		Vector<ConstraintData *> &constraints = skin.getConstraints();
+		Vector<int> ik, transform, path, physics;
+		for (size_t i = 0; i < constraints.size(); i++) {
+			ConstraintData *constraint = constraints[i];
+			if (constraint->getRTTI().isExactly(IkConstraintData::rtti))
+				ik.add(_skeletonData->getIkConstraints().indexOf(static_cast<IkConstraintData *>(constraint)));
+			else if (constraint->getRTTI().isExactly(TransformConstraintData::rtti))
+				transform.add(_skeletonData->getTransformConstraints().indexOf(static_cast<TransformConstraintData *>(constraint)));
+			else if (constraint->getRTTI().isExactly(PathConstraintData::rtti))
+				path.add(_skeletonData->getPathConstraints().indexOf(static_cast<PathConstraintData *>(constraint)));
+			else if (constraint->getRTTI().isExactly(PhysicsConstraintData::rtti))
+				physics.add(_skeletonData->getPhysicsConstraints().indexOf(static_cast<PhysicsConstraintData *>(constraint)));
+		}
+		Vector<int> *lists[] = {&ik, &transform, &path, &physics};
+		for (int i = 0; i < 4; i++) {
+			writeVarint((int) lists[i]->size(), true);
+			for (size_t ii = 0; ii < lists[i]->size(); ii++)
+				writeVarint((*lists[i])[ii], true);
+		}
+	}
+
+	size_t slotCount = _skeletonData->getSlots().size();
+	int usedSlots = 0;
+	for (size_t slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+		Vector<String> names;
+		skin.findNamesForSlot(slotIndex, names);
+		if (names.size() > 0) usedSlots++;
+	}
+	writeVarint(usedSlots, true);
+	for (size_t slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+		Vector<String> names;
+		skin.findNamesForSlot(slotIndex, names);
+		if (names.size() == 0) continue;
+		writeVarint((int) slotIndex, true);
+		writeVarint((int) names.size(), true);
+		for (size_t i = 0; i < names.size(); i++) {
+			writeStringRef(names[i]);
+			if (!writeAttachment(names[i], skin.getAttachment(slotIndex, names[i]), (int) slotIndex)) return false;
+		}
+	}
+	return true;
+}
+
+void SkeletonBinaryWriter::writeSequence(Sequence *sequence) {
+	writeVarint((int) sequence->getRegions().size(), true);
+	writeVarint(sequence->getStart(), true);
+	writeVarint(sequence->getDigits(), true);
+	writeVarint(sequence->getSetupIndex(), true);
+}
+
+bool SkeletonBinaryWriter::writeAttachment(const String &key, Attachment *attachment, int slotIndex) {
+	const String &name = attachment->getName();
+	int nameFlag = name == key ? 0 : 8;
+	const RTTI &rtti = attachment->getRTTI();
+
+	if (rtti.isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+		Color &color = region->getColor();
+		bool white = color.r == 1 && color.g == 1 && color.b == 1 && color.a == 1;
+		int flags = AttachmentType_Region | nameFlag;
+		if (region->getPath() != name) flags |= 16;
+		if (!white) flags |= 32;
+		if (region->getSequence()) flags |= 64;
+		if (region->getRotation() != 0) flags |= 128;
+		writeByte(flags);
+		if (nameFlag) writeStringRef(name);
+		if (flags & 16) writeStringRef(region->getPath());
+		if (flags & 32) writeColor(color);
+		if (flags & 64) writeSequence(region->getSequence());
+		if (flags & 128) writeFloat(region->getRotation());
+		writeFloat(region->getX());
+		writeFloat(region->getY());
+		writeFloat(region->getScaleX());
+		writeFloat(region->getScaleY());
+		writeFloat(region->getWidth());
+		writeFloat(region->getHeight());
+		return true;
+	}
+
+	if (rtti.isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+		Color &color = mesh->getColor();
+		bool white = color.r == 1 && color.g == 1 && color.b == 1 && color.a == 1;
+		MeshAttachment *parent = mesh->getParentMesh();
+		int flags = (parent ? AttachmentType_Linkedmesh : AttachmentType_Mesh) | nameFlag;
+		if (mesh->getPath() != name) flags |= 16;
+		if (!white) flags |= 32;
+		if (mesh->getSequence()) flags |= 64;
+		if (parent ? mesh->getTimelineAttachment() != mesh : mesh->getBones().size() > 0) flags |= 128;
+		writeByte(flags);
+		if (nameFlag) writeStringRef(name);
+		if (flags & 16) writeStringRef(mesh->getPath());
+		if (flags & 32) writeColor(color);
+		if (flags & 64) writeSequence(mesh->getSequence());
+
+		if (parent) {
+			int parentSkin;
+			String parentKey;
+			if (!findAttachment(parent, slotIndex, parentSkin, parentKey)) {
+				setError("Parent mesh not found in any skin: ", name.buffer());
+				return false;
+			}
+			writeVarint(parentSkin, true);
+			writeStringRef(parentKey);
+			writeFloat(mesh->getWidth());
+			writeFloat(mesh->getHeight());
+			return true;
+		}
+
+		// The reader derives the triangle count from the hull length
+		int verticesLength = (int) mesh->getWorldVerticesLength();
+		Vector<unsigned short> &triangles = mesh->getTriangles();
+		writeVarint(verticesLength - 2 - (int) triangles.size() / 3, true);
+		writeVertices(*mesh);
+		Vector<float> &uvs = mesh->getRegionUVs();
+		for (int i = 0; i < verticesLength; i++)
+			writeFloat(uvs[i]);
+		for (size_t i = 0; i < triangles.size(); i++)
+			writeVarint(triangles[i], true);
+		Vector<unsigned short> &edges = mesh->getEdges();
+		writeVarint((int) edges.size(), true);
+		for (size_t i = 0; i < edges.size(); i++)
+			writeVarint(edges[i], true);
+		writeFloat(mesh->getWidth());
+		writeFloat(mesh->getHeight());
+		return true;
+	}
+
+	if (rtti.isExactly(BoundingBoxAttachment::rtti)) {
+		BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
+		writeByte(AttachmentType_Boundingbox | nameFlag | (box->getBones().size() > 0 ? 16 : 0));
+		if (nameFlag) writeStringRef(name);
+		writeVertices(*box);
+		writeColor(box->getColor());
+		return true;
+	}
+
+	if (rtti.isExactly(PathAttachment::rtti)) {
+		PathAttachment *path = static_cast<PathAttachment *>(attachment);
+		int flags = AttachmentType_Path | nameFlag;
+		if (path->isClosed()) flags |= 16;
+		if (path->isConstantSpeed()) flags |= 32;
+		if (path->getBones().size() > 0) flags |= 64;
+		writeByte(flags);
+		if (nameFlag) writeStringRef(name);
+		writeVertices(*path);
+		Vector<float> &lengths = path->getLengths();
+		for (int i = 0, n = (int) path->getWorldVerticesLength() / 6; i < n; i++)
+			writeFloat(lengths[i]);
+		writeColor(path->getColor());
+		return true;
+	}
+
+	if (rtti.isExactly(PointAttachment::rtti)) {
+		PointAttachment *point = static_cast<PointAttachment *>(attachment);
+		writeByte(AttachmentType_Point | nameFlag);
+		if (nameFlag) writeStringRef(name);
+		writeFloat(point->getRotation());
+		writeFloat(point->getX());
+		writeFloat(point->getY());
+		writeColor(point->getColor());
+		return true;
+	}
+
+	if (rtti.isExactly(ClippingAttachment::rtti)) {
+		ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
+		writeByte(AttachmentType_Clipping | nameFlag | (clip->getBones().size() > 0 ? 16 : 0));
+		if (nameFlag) writeStringRef(name);
+		// Without an end slot clipping lasts until the last slot
+		SlotData *endSlot = clip->getEndSlot();
+		writeVarint(endSlot ? endSlot->getIndex() : (int) _skeletonData->getSlots().size() - 1, true);
+		writeVertices(*clip);
+		writeColor(clip->getColor());
+		return true;
+	}
+
+	setError("Unsupported attachment type: ", name.buffer());
+	return false;
+}
+
+void SkeletonBinaryWriter::writeVertices(VertexAttachment &attachment) {
+	int vertexCount = (int) attachment.getWorldVerticesLength() >> 1;
+	Vector<float> &vertices = attachment.getVertices();
+	Vector<int> &bones = attachment.getBones();
+	writeVarint(vertexCount, true);
+	if (bones.size() == 0) {
+		for (size_t i = 0; i < vertices.size(); i++)
+			writeFloat(vertices[i]);
+		return;
+	}
+	for (size_t v = 0, b = 0; v < vertices.size();) {
+		int boneCount = bones[b++];
+		writeVarint(boneCount, true);
+		for (int i = 0; i < boneCount; i++, v += 3) {
+			writeVarint(bones[b++], true);
+			writeFloat(vertices[v]);
+			writeFloat(vertices[v + 1]);
+			writeFloat(vertices[v + 2]);
+		}
+	}
+}
+
+void SkeletonBinaryWriter::writeBeziers(CurveTimeline &timeline, int frame, int valueCount) {
+	Vector<float> &frames = timeline.getFrames();
+	Vector<float> &curves = timeline.getCurves();
+	int entries = (int) timeline.getFrameEntries();
+	int i = (int) curves[frame] - CURVE_BEZIER;
+	float time1 = frames[frame * entries], time2 = frames[(frame + 1) * entries];
+	// Deform timelines interpolate from 0 to 1, their frames hold only the time
+	bool unit = entries == 1;
+	for (int value = 0; value < valueCount; value++, i += BEZIER_SIZE) {
+		float value1 = unit ? 0 : frames[frame * entries + 1 + value];
+		float value2 = unit ? 1 : frames[(frame + 1) * entries + 1 + value];
+		float cx1, cy1, cx2, cy2;
+		bezierControlPoints(&curves[i], 0, time1, time2, cx1, cx2);
+		bezierControlPoints(&curves[i], 1, value1, value2, cy1, cy2);
+		writeFloat(cx1);
+		writeFloat(cy1);
+		writeFloat(cx2);
+		writeFloat(cy2);
+	}
+}
+
+void SkeletonBinaryWriter::writeCurve(CurveTimeline &timeline, int frame, int valueCount) {
+	int type = (int) timeline.getCurves()[frame];
+	if (type >= CURVE_BEZIER) {
+		writeByte(SkeletonBinary::CURVE_BEZIER);
+		writeBeziers(timeline, frame, valueCount);
+	} else {
+		writeByte(type == CURVE_STEPPED ? SkeletonBinary::CURVE_STEPPED : SkeletonBinary::CURVE_LINEAR);
+	}
+}
+
+void SkeletonBinaryWriter::writeCurveFrames(CurveTimeline &timeline, int valueCount, bool colorBytes) {
+	Vector<float> &frames = timeline.getFrames();
+	int entries = (int) timeline.getFrameEntries();
+	int frameCount = (int) timeline.getFrameCount();
+	writeVarint(((int) timeline.getCurves().size() - frameCount) / BEZIER_SIZE, true);
+	for (int frame = 0; frame < frameCount; frame++) {
+		const float *values = &frames[frame * entries];
+		writeFloat(values[0]);
+		for (int value = 1; value <= valueCount; value++) {
+			if (colorBytes)
+				writeByte(colorByte(values[value]));
+			else
+				writeFloat(values[value]);
+		}
+		if (frame > 0) writeCurve(timeline, frame - 1, valueCount);
+	}
+}
+
+bool SkeletonBinaryWriter::writeAnimation(Animation &animation) {
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	SkeletonData &skeletonData = *_skeletonData;
+	writeVarint((int) timelines.size(), true);
+
+	// Group the timelines the way the format stores them
+	Vector<Vector<Timeline *> > slotTimelines, boneTimelines, pathTimelines, physicsTimelines;
+	Vector<IkConstraintTimeline *> ikTimelines;
+	Vector<TransformConstraintTimeline *> transformTimelines;
+	Vector<Timeline *> attachmentTimelines;
+	Vector<int> attachmentSkins, attachmentSlots;
+	Vector<String> attachmentNames;
+	DrawOrderTimeline *drawOrderTimeline = NULL;
+	EventTimeline *eventTimeline = NULL;
+	slotTimelines.setSize(skeletonData.getSlots().size(), Vector<Timeline *>());
+	boneTimelines.setSize(skeletonData.getBones().size(), Vector<Timeline *>());
+	pathTimelines.setSize(skeletonData.getPathConstraints().size(), Vector<Timeline *>());
+	physicsTimelines.setSize(skeletonData.getPhysicsConstraints().size() + 1, Vector<Timeline *>());
+
+	for (size_t i = 0; i < timelines.size(); i++) {
+		Timeline *timeline = timelines[i];
+		const RTTI &rtti = timeline->getRTTI();
+		if (rtti.isExactly(AttachmentTimeline::rtti))
+			slotTimelines[static_cast<AttachmentTimeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(RGBATimeline::rtti))
+			slotTimelines[static_cast<RGBATimeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(RGBTimeline::rtti))
+			slotTimelines[static_cast<RGBTimeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(RGBA2Timeline::rtti))
+			slotTimelines[static_cast<RGBA2Timeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(RGB2Timeline::rtti))
+			slotTimelines[static_cast<RGB2Timeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(AlphaTimeline::rtti))
+			slotTimelines[static_cast<AlphaTimeline *>(timeline)->getSlotIndex()].add(timeline);
+		else if (rtti.isExactly(RotateTimeline::rtti))
+			boneTimelines[static_cast<RotateTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(TranslateTimeline::rtti))
+			boneTimelines[static_cast<TranslateTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(TranslateXTimeline::rtti))
+			boneTimelines[static_cast<TranslateXTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(TranslateYTimeline::rtti))
+			boneTimelines[static_cast<TranslateYTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ScaleTimeline::rtti))
+			boneTimelines[static_cast<ScaleTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ScaleXTimeline::rtti))
+			boneTimelines[static_cast<ScaleXTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ScaleYTimeline::rtti))
+			boneTimelines[static_cast<ScaleYTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ShearTimeline::rtti))
+			boneTimelines[static_cast<ShearTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ShearXTimeline::rtti))
+			boneTimelines[static_cast<ShearXTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(ShearYTimeline::rtti))
+			boneTimelines[static_cast<ShearYTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(InheritTimeline::rtti))
+			boneTimelines[static_cast<InheritTimeline *>(timeline)->getBoneIndex()].add(timeline);
+		else if (rtti.isExactly(IkConstraintTimeline::rtti))
+			ikTimelines.add(static_cast<IkConstraintTimeline *>(timeline));
+		else if (rtti.isExactly(TransformConstraintTimeline::rtti))
+			transformTimelines.add(static_cast<TransformConstraintTimeline *>(timeline));
+		else if (rtti.isExactly(PathConstraintPositionTimeline::rtti))
+			pathTimelines[static_cast<PathConstraintPositionTimeline *>(timeline)->getPathConstraintIndex()].add(timeline);
+		else if (rtti.isExactly(PathConstraintSpacingTimeline::rtti))
+			pathTimelines[static_cast<PathConstraintSpacingTimeline *>(timeline)->getPathConstraintIndex()].add(timeline);
+		else if (rtti.isExactly(PathConstraintMixTimeline::rtti))
+			pathTimelines[static_cast<PathConstraintMixTimeline *>(timeline)->getPathConstraintIndex()].add(timeline);
+		else if (rtti.isExactly(PhysicsConstraintResetTimeline::rtti))
+			physicsTimelines[static_cast<PhysicsConstraintResetTimeline *>(timeline)->getPhysicsConstraintIndex() + 1].add(timeline);
+		else if (rtti.instanceOf(PhysicsConstraintTimeline::rtti))
+			physicsTimelines[static_cast<PhysicsConstraintTimeline *>(timeline)->getPhysicsConstraintIndex() + 1].add(timeline);
+		else if (rtti.isExactly(DeformTimeline::rtti) || rtti.isExactly(SequenceTimeline::rtti)) {
+			bool deform = rtti.isExactly(DeformTimeline::rtti);
+			int slotIndex = deform ? static_cast<DeformTimeline *>(timeline)->getSlotIndex()
+								   : static_cast<SequenceTimeline *>(timeline)->getSlotIndex();
+			Attachment *attachment = deform ? static_cast<DeformTimeline *>(timeline)->getAttachment()
+											: static_cast<SequenceTimeline *>(timeline)->getAttachment();
+			int skin;
+			String name;
+			if (!findAttachment(attachment, slotIndex, skin, name)) {
+				setError("Timeline attachment not found in any skin: ", animation.getName().buffer());
+				return false;
+			}
+			attachmentTimelines.add(timeline);
+			attachmentSkins.add(skin);
+			attachmentSlots.add(slotIndex);
+			attachmentNames.add(name);
+		} else if (rtti.isExactly(DrawOrderTimeline::rtti))
+			drawOrderTimeline = static_cast<DrawOrderTimeline *>(timeline);
+		else if (rtti.isExactly(EventTimeline::rtti))
+			eventTimeline = static_cast<EventTimeline *>(timeline);
+		else {
+			setError("Unsupported timeline type in animation: ", animation.getName().buffer());
+			return false;
+		}
+	}
+
+	// Slot timelines.
+	int count = 0;
+	for (size_t i = 0; i < slotTimelines.size(); i++)
+		if (slotTimelines[i].size() > 0) count++;
+	writeVarint(count, true);
+	for (size_t i = 0; i < slotTimelines.size(); i++) {
+		Vector<Timeline *> &group = slotTimelines[i];
+		if (group.size() == 0) continue;
+		writeVarint((int) i, true);
+		writeVarint((int) group.size(), true);
+		for (size_t ii = 0; ii < group.size(); ii++) {
+			Timeline *timeline = group[ii];
+			const RTTI &rtti = timeline->getRTTI();
+			int frameCount = (int) timeline->getFrameCount();
+			if (rtti.isExactly(AttachmentTimeline::rtti)) {
+				writeByte(SkeletonBinary::SLOT_ATTACHMENT);
+				writeVarint(frameCount, true);
+				Vector<String> &names = static_cast<AttachmentTimeline *>(timeline)->getAttachmentNames();
+				for (int frame = 0; frame < frameCount; frame++) {
+					writeFloat(timeline->getFrames()[frame]);
+					writeStringRef(names[frame]);
+				}
+				continue;
+			}
+			int type, valueCount;
+			if (rtti.isExactly(RGBATimeline::rtti))
+				type = SkeletonBinary::SLOT_RGBA, valueCount = 4;
+			else if (rtti.isExactly(RGBTimeline::rtti))
+				type = SkeletonBinary::SLOT_RGB, valueCount = 3;
+			else if (rtti.isExactly(RGBA2Timeline::rtti))
+				type = SkeletonBinary::SLOT_RGBA2, valueCount = 7;
+			else if (rtti.isExactly(RGB2Timeline::rtti))
+				type = SkeletonBinary::SLOT_RGB2, valueCount = 6;
+			else
+				type = SkeletonBinary::SLOT_ALPHA, valueCount = 1;
+			writeByte(type);
+			writeVarint(frameCount, true);
+			writeCurveFrames(*static_cast<CurveTimeline *>(timeline), valueCount, true);
+		}
+	}
+
+	// Bone timelines.
+	count = 0;
+	for (size_t i = 0; i < boneTimelines.size(); i++)
+		if (boneTimelines[i].size() > 0) count++;
+	writeVarint(count, true);
+	for (size_t i = 0; i < boneTimelines.size(); i++) {
+		Vector<Timeline *> &group = boneTimelines[i];
+		if (group.size() == 0) continue;
+		writeVarint((int) i, true);
+		writeVarint((int) group.size(), true);
+		for (size_t ii = 0; ii < group.size(); ii++) {
+			Timeline *timeline = group[ii];
+			const RTTI &rtti = timeline->getRTTI();
+			int frameCount = (int) timeline->getFrameCount();
+			if (rtti.isExactly(InheritTimeline::rtti)) {
+				writeByte(SkeletonBinary::BONE_INHERIT);
+				writeVarint(frameCount, true);
+				int entries = (int) timeline->getFrameEntries();
+				for (int frame = 0; frame < frameCount; frame++) {
+					writeFloat(timeline->getFrames()[frame * entries]);
+					writeByte((int) timeline->getFrames()[frame * entries + 1]);
+				}
+				continue;
+			}
+			int type, valueCount = 1;
+			if (rtti.isExactly(RotateTimeline::rtti))
+				type = SkeletonBinary::BONE_ROTATE;
+			else if (rtti.isExactly(TranslateTimeline::rtti))
+				type = SkeletonBinary::BONE_TRANSLATE, valueCount = 2;
+			else if (rtti.isExactly(TranslateXTimeline::rtti))
+				type = SkeletonBinary::BONE_TRANSLATEX;
+			else if (rtti.isExactly(TranslateYTimeline::rtti))
+				type = SkeletonBinary::BONE_TRANSLATEY;
+			else if (rtti.isExactly(ScaleTimeline::rtti))
+				type = SkeletonBinary::BONE_SCALE, valueCount = 2;
+			else if (rtti.isExactly(ScaleXTimeline::rtti))
+				type = SkeletonBinary::BONE_SCALEX;
+			else if (rtti.isExactly(ScaleYTimeline::rtti))
+				type = SkeletonBinary::BONE_SCALEY;
+			else if (rtti.isExactly(ShearTimeline::rtti))
+				type = SkeletonBinary::BONE_SHEAR, valueCount = 2;
+			else if (rtti.isExactly(ShearXTimeline::rtti))
+				type = SkeletonBinary::BONE_SHEARX;
+			else
+				type = SkeletonBinary::BONE_SHEARY;
+			writeByte(type);
+			writeVarint(frameCount, true);
+			writeCurveFrames(*static_cast<CurveTimeline *>(timeline), valueCount, false);
+		}
+	}
+
+	// IK timelines. Mix and softness are optional per frame, flags carry the curve type of the previous frame.
+	writeVarint((int) ikTimelines.size(), true);
+	for (size_t i = 0; i < ikTimelines.size(); i++) {
+		IkConstraintTimeline *timeline = ikTimelines[i];
+		Vector<float> &frames = timeline->getFrames();
+		int frameCount = (int) timeline->getFrameCount();
+		writeVarint(timeline->getIkConstraintIndex(), true);
+		writeVarint(frameCount, true);
+		writeVarint(((int) timeline->getCurves().size() - frameCount) / BEZIER_SIZE, true);
+		for (int frame = 0; frame < frameCount; frame++) {
+			const float *values = &frames[frame * timeline->getFrameEntries()];
+			float mix = values[1], softness = values[2];
+			int flags = 0;
+			if (mix != 0) flags |= mix != 1 ? 1 | 2 : 1;
+			if (softness != 0) flags |= 4;
+			if (values[3] > 0) flags |= 8;
+			if (values[4] != 0) flags |= 16;
+			if (values[5] != 0) flags |= 32;
+			int curve = frame > 0 ? (int) timeline->getCurves()[frame - 1] : CURVE_LINEAR;
+			if (curve == CURVE_STEPPED)
+				flags |= 64;
+			else if (curve >= CURVE_BEZIER)
+				flags |= 128;
+			writeByte(flags);
+			writeFloat(values[0]);
+			if (flags & 2) writeFloat(mix);
+			if (flags & 4) writeFloat(softness);
+			if (flags & 128) writeBeziers(*timeline, frame - 1, 2);
+		}
+	}
+
+	// Transform constraint timelines.
+	writeVarint((int) transformTimelines.size(), true);
+	for (size_t i = 0; i < transformTimelines.size(); i++) {
+		TransformConstraintTimeline *timeline = transformTimelines[i];
+		writeVarint(timeline->getTransformConstraintIndex(), true);
+		writeVarint((int) timeline->getFrameCount(), true);
+		writeCurveFrames(*timeline, 6, false);
+	}
+
+	// Path constraint timelines.
+	count = 0;
+	for (size_t i = 0; i < pathTimelines.size(); i++)
+		if (pathTimelines[i].size() > 0) count++;
+	writeVarint(count, true);
+	for (size_t i = 0; i < pathTimelines.size(); i++) {
+		Vector<Timeline *> &group = pathTimelines[i];
+		if (group.size() == 0) continue;
+		writeVarint((int) i, true);
+		writeVarint((int) group.size(), true);
+		for (size_t ii = 0; ii < group.size(); ii++) {
+			Timeline *timeline = group[ii];
+			const RTTI &rtti = timeline->getRTTI();
+			if (rtti.isExactly(PathConstraintMixTimeline::rtti)) {
+				writeByte(SkeletonBinary::PATH_MIX);
+				writeVarint((int) timeline->getFrameCount(), true);
+				writeCurveFrames(*static_cast<CurveTimeline *>(timeline), 3, false);
+			} else {
+				writeByte(rtti.isExactly(PathConstraintPositionTimeline::rtti) ? SkeletonBinary::PATH_POSITION
+																				: SkeletonBinary::PATH_SPACING);
+				writeVarint((int) timeline->getFrameCount(), true);
+				writeCurveFrames(*static_cast<CurveTimeline *>(timeline), 1, false);
+			}
+		}
+	}
+
+	// Physics timelines, index 0 is for timelines that apply to all physics constraints.
+	count = 0;
+	for (size_t i = 0; i < physicsTimelines.size(); i++)
+		if (physicsTimelines[i].size() > 0) count++;
+	writeVarint(count, true);
+	for (size_t i = 0; i < physicsTimelines.size(); i++) {
+		Vector<Timeline *> &group = physicsTimelines[i];
+		if (group.size() == 0) continue;
+		writeVarint((int) i, true);
+		writeVarint((int) group.size(), true);
+		for (size_t ii = 0; ii < group.size(); ii++) {
+			Timeline *timeline = group[ii];
+			const RTTI &rtti = timeline->getRTTI();
+			int frameCount = (int) timeline->getFrameCount();
+			if (rtti.isExactly(PhysicsConstraintResetTimeline::rtti)) {
+				writeByte(SkeletonBinary::PHYSICS_RESET);
+				writeVarint(frameCount, true);
+				for (int frame = 0; frame < frameCount; frame++)
+					writeFloat(timeline->getFrames()[frame]);
+				continue;
+			}
+			int type;
+			if (rtti.isExactly(PhysicsConstraintInertiaTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_INERTIA;
+			else if (rtti.isExactly(PhysicsConstraintStrengthTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_STRENGTH;
+			else if (rtti.isExactly(PhysicsConstraintDampingTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_DAMPING;
+			else if (rtti.isExactly(PhysicsConstraintMassTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_MASS;
+			else if (rtti.isExactly(PhysicsConstraintWindTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_WIND;
+			else if (rtti.isExactly(PhysicsConstraintGravityTimeline::rtti))
+				type = SkeletonBinary::PHYSICS_GRAVITY;
+			else
+				type = SkeletonBinary::PHYSICS_MIX;
+			writeByte(type);
+			writeVarint(frameCount, true);
+			writeCurveFrames(*static_cast<CurveTimeline *>(timeline), 1, false);
+		}
+	}
+
+	// Attachment timelines, by skin, slot and attachment.
+	int skinCount = (int) skeletonData.getSkins().size();
+	count = 0;
+	for (int skin = 0; skin < skinCount; skin++)
+		if (attachmentSkins.contains(skin)) count++;
+	writeVarint(count, true);
+	for (int skin = 0; skin < skinCount; skin++) {
+		if (!attachmentSkins.contains(skin)) continue;
+		Vector<int> slots;
+		for (size_t i = 0; i < attachmentTimelines.size(); i++)
+			if (attachmentSkins[i] == skin && !slots.contains(attachmentSlots[i])) slots.add(attachmentSlots[i]);
+		writeVarint(skin, true);
+		writeVarint((int) slots.size(), true);
+		for (size_t s = 0; s < slots.size(); s++) {
+			Vector<size_t> entries;
+			for (size_t i = 0; i < attachmentTimelines.size(); i++)
+				if (attachmentSkins[i] == skin && attachmentSlots[i] == slots[s]) entries.add(i);
+			writeVarint(slots[s], true);
+			writeVarint((int) entries.size(), true);
+			for (size_t e = 0; e < entries.size(); e++) {
+				size_t index = entries[e];
+				Timeline *timeline = attachmentTimelines[index];
+				int frameCount = (int) timeline->getFrameCount();
+				writeStringRef(attachmentNames[index]);
+				if (timeline->getRTTI().isExactly(SequenceTimeline::rtti)) {
+					writeByte(SkeletonBinary::ATTACHMENT_SEQUENCE);
+					writeVarint(frameCount, true);
+					Vector<float> &frames = timeline->getFrames();
+					int entries = (int) timeline->getFrameEntries();
+					for (int frame = 0; frame < frameCount; frame++) {
+						writeFloat(frames[frame * entries]);
+						writeInt((int) frames[frame * entries + 1]);
+						writeFloat(frames[frame * entries + 2]);
+					}
+					continue;
+				}
+
+				// Deform keys store the offsets from the setup vertices, only the range that is not zero
+				DeformTimeline *deform = static_cast<DeformTimeline *>(timeline);
+				VertexAttachment *attachment = deform->getAttachment();
+				bool weighted = attachment->getBones().size() > 0;
+				Vector<float> &setup = attachment->getVertices();
+				writeByte(SkeletonBinary::ATTACHMENT_DEFORM);
+				writeVarint(frameCount, true);
+				writeVarint(((int) deform->getCurves().size() - frameCount) / BEZIER_SIZE, true);
+				writeFloat(deform->getFrames()[0]);
+				for (int frame = 0; frame < frameCount; frame++) {
+					Vector<float> &vertices = deform->getVertices()[frame];
+					Vector<float> offsets;
+					offsets.setSize(vertices.size(), 0);
+					int start = -1, end = 0;
+					for (size_t v = 0; v < vertices.size(); v++) {
+						offsets[v] = weighted ? vertices[v] : vertices[v] - setup[v];
+						if (offsets[v] == 0) continue;
+						if (start == -1) start = (int) v;
+						end = (int) v + 1;
+					}
+					if (start == -1) {
+						writeVarint(0, true);
+					} else {
+						writeVarint(end - start, true);
+						writeVarint(start, true);
+						for (int v = start; v < end; v++)
+							writeFloat(offsets[v]);
+					}
+					if (frame == frameCount - 1) break;
+					writeFloat(deform->getFrames()[frame + 1]);
+					writeCurve(*deform, frame, 1);
+				}
+			}
+		}
+	}
+
+	// Draw order timeline, each key lists the slots that moved and by how much.
+	if (drawOrderTimeline) {
+		int frameCount = (int) drawOrderTimeline->getFrameCount();
+		size_t slotCount = skeletonData.getSlots().size();
+		writeVarint(frameCount, true);
+		for (int frame = 0; frame < frameCount; frame++) {
+			writeFloat(drawOrderTimeline->getFrames()[frame]);
+			Vector<int> &drawOrder = drawOrderTimeline->getDrawOrders()[frame];
+			if (drawOrder.size() == 0) {
+				writeVarint(0, true);
+				continue;
+			}
+			Vector<int> positions;
+			positions.setSize(slotCount, 0);
+			int moved = 0;
+			for (size_t i = 0; i < slotCount; i++) {
+				positions[drawOrder[i]] = (int) i;
+				if (drawOrder[i] != (int) i) moved++;
+			}
+			writeVarint(moved, true);
+			for (size_t slotIndex = 0; slotIndex < slotCount; slotIndex++) {
+				if (positions[slotIndex] == (int) slotIndex) continue;
+				writeVarint((int) slotIndex, true);
+				writeVarint(positions[slotIndex] - (int) slotIndex, true);
+			}
+		}
+	} else {
+		writeVarint(0, true);
+	}
+
+	// Event timeline.
+	if (eventTimeline) {
+		Vector<Event *> &events = eventTimeline->getEvents();
+		writeVarint((int) events.size(), true);
+		for (size_t i = 0; i < events.size(); i++) {
+			Event *event = events[i];
+			const EventData &data = event->getData();
+			writeFloat(eventTimeline->getFrames()[i]);
+			writeVarint(skeletonData.getEvents().indexOf(const_cast<EventData *>(&data)), true);
+			writeVarint(event->getIntValue(), false);
+			writeFloat(event->getFloatValue());
+			// NULL reads back as the event data's string
+			if (event->getStringValue() == data.getStringValue())
+				writeVarint(0, true);
+			else
+				writeString(event->getStringValue());
+			if (!data.getAudioPath().isEmpty()) {
+				writeFloat(event->getVolume());
+				writeFloat(event->getBalance());
+			}
+		}
+	} else {
+		writeVarint(0, true);
+	}
+	return true;
+}
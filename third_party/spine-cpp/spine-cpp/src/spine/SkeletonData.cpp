@@ -45,6 +45,7 @@ using namespace spine;
 
 SkeletonData::SkeletonData() : _name(),
 							   _defaultSkin(NULL),
+							   _animationSource(NULL),
 							   _x(0),
 							   _y(0),
 							   _width(0),
@@ -65,6 +66,7 @@ SkeletonData::~SkeletonData() {
 
 	ContainerUtil::cleanUpVectorOfPointers(_events);
 	ContainerUtil::cleanUpVectorOfPointers(_animations);
+	delete _animationSource;
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
@@ -75,39 +77,76 @@ SkeletonData::~SkeletonData() {
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	int index = _boneIndex.find(_bones, boneName);
+	return index == -1 ? NULL : _bones[index];
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	int index = _slotIndex.find(_slots, slotName);
+	return index == -1 ? NULL : _slots[index];
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	int index = _skinIndex.find(_skins, skinName);
+	return index == -1 ? NULL : _skins[index];
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	int index = _eventIndex.find(_events, eventDataName);
+	return index == -1 ? NULL : _events[index];
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	int index = _animationIndex.find(_animations, animationName);
+	if (index == -1) return NULL;
+	Animation *animation = _animations[index];
+	animation->load();
+	return animation;
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	int index = _ikConstraintIndex.find(_ikConstraints, constraintName);
+	return index == -1 ? NULL : _ikConstraints[index];
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	int index = _transformConstraintIndex.find(_transformConstraints, constraintName);
+	return index == -1 ? NULL : _transformConstraints[index];
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	int index = _pathConstraintIndex.find(_pathConstraints, constraintName);
+	return index == -1 ? NULL : _pathConstraints[index];
 }
 
 PhysicsConstraintData *SkeletonData::findPhysicsConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_physicsConstraints, constraintName);
+	int index = _physicsConstraintIndex.find(_physicsConstraints, constraintName);
+	return index == -1 ? NULL : _physicsConstraints[index];
+}
+
+int SkeletonData::findBoneIndex(const String &boneName) {
+	return _boneIndex.find(_bones, boneName);
+}
+
+int SkeletonData::findSlotIndex(const String &slotName) {
+	return _slotIndex.find(_slots, slotName);
+}
+
+int SkeletonData::findSkinIndex(const String &skinName) {
+	return _skinIndex.find(_skins, skinName);
+}
+
+int SkeletonData::findEventIndex(const String &eventDataName) {
+	return _eventIndex.find(_events, eventDataName);
+}
+
+void SkeletonData::releaseAnimations() {
+	for (size_t i = 0; i < _animations.size(); i++)
+		_animations[i]->release();
+}
+
+int SkeletonData::findAnimationIndex(const String &animationName) {
+	return _animationIndex.find(_animations, animationName);
 }
 
 const String &SkeletonData::getName() {
@@ -119,14 +158,17 @@ void SkeletonData::setName(const String &inValue) {
 }
 
 Vector<BoneData *> &SkeletonData::getBones() {
+	_boneIndex.clear();
 	return _bones;
 }
 
 Vector<SlotData *> &SkeletonData::getSlots() {
+	_slotIndex.clear();
 	return _slots;
 }
 
 Vector<Skin *> &SkeletonData::getSkins() {
+	_skinIndex.clear();
 	return _skins;
 }
 
@@ -139,26 +181,32 @@ void SkeletonData::setDefaultSkin(Skin *inValue) {
 }
 
 Vector<spine::EventData *> &SkeletonData::getEvents() {
+	_eventIndex.clear();
 	return _events;
 }
 
 Vector<Animation *> &SkeletonData::getAnimations() {
+	_animationIndex.clear();
 	return _animations;
 }
 
 Vector<IkConstraintData *> &SkeletonData::getIkConstraints() {
+	_ikConstraintIndex.clear();
 	return _ikConstraints;
 }
 
 Vector<TransformConstraintData *> &SkeletonData::getTransformConstraints() {
+	_transformConstraintIndex.clear();
 	return _transformConstraints;
 }
 
 Vector<PathConstraintData *> &SkeletonData::getPathConstraints() {
+	_pathConstraintIndex.clear();
 	return _pathConstraints;
 }
 
 Vector<PhysicsConstraintData *> &SkeletonData::getPhysicsConstraints() {
+	_physicsConstraintIndex.clear();
 	return _physicsConstraints;
 }
 
@@ -935,7 +935,7 @@ Timeline *SkeletonJson::readTimeline(Json *keyMap, CurveTimeline2 *timeline, con
 }
 
 int SkeletonJson::findSlotIndex(SkeletonData *skeletonData, const String &slotName, Vector<Timeline *> timelines) {
-	int slotIndex = ContainerUtil::findIndexWithName(skeletonData->getSlots(), slotName);
+	int slotIndex = skeletonData->findSlotIndex(slotName);
 	if (slotIndex == -1) {
 		ContainerUtil::cleanUpVectorOfPointers(timelines);
 		setError(NULL, "Slot not found: ", slotName);
@@ -1609,6 +1609,7 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
+	attachment->prepareWeights();
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
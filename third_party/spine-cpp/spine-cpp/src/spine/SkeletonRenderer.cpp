@@ -136,111 +136,170 @@ static RenderCommand *batchCommands(BlockAllocator &allocator, Vector<RenderComm
 	return root;
 }
 
+bool SkeletonRenderer::computeSlot(Skeleton &skeleton, Slot &slot, SlotGeometry &geometry) {
+	SkeletonClipping &clipper = _clipping;
+	Attachment *attachment = slot.getAttachment();
+	if (!attachment) {
+		clipper.clipEnd(slot);
+		return false;
+	}
+
+	// Early out if the slot color is 0 or the bone is not active
+	if ((slot.getColor().a == 0 || !slot.getBone().isActive()) && !attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+		clipper.clipEnd(slot);
+		return false;
+	}
+
+	Vector<float> *worldVertices = &_worldVertices;
+	Color *attachmentColor;
+	geometry.vertices = worldVertices;
+
+	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
+		attachmentColor = &regionAttachment->getColor();
+
+		// Early out if the slot color is 0
+		if (attachmentColor->a == 0) {
+			clipper.clipEnd(slot);
+			return false;
+		}
+
+		worldVertices->setSize(8, 0);
+		regionAttachment->computeWorldVertices(slot, *worldVertices, 0, 2);
+		geometry.verticesCount = 4;
+		geometry.uvs = &regionAttachment->getUVs();
+		geometry.indices = &_quadIndices;
+		geometry.indicesCount = 6;
+		geometry.texture = regionAttachment->getRegion()->rendererObject;
+
+	} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = (MeshAttachment *) attachment;
+		attachmentColor = &mesh->getColor();
+
+		// Early out if the slot color is 0
+		if (attachmentColor->a == 0) {
+			clipper.clipEnd(slot);
+			return false;
+		}
+
+		worldVertices->setSize(mesh->getWorldVerticesLength(), 0);
+		mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices->buffer(), 0, 2);
+		geometry.verticesCount = (int32_t) (mesh->getWorldVerticesLength() >> 1);
+		geometry.uvs = &mesh->getUVs();
+		geometry.indices = &mesh->getTriangles();
+		geometry.indicesCount = (int32_t) geometry.indices->size();
+		geometry.texture = mesh->getRegion()->rendererObject;
+
+	} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+		ClippingAttachment *clip = (ClippingAttachment *) slot.getAttachment();
+		clipper.clipStart(slot, clip);
+		return false;
+	} else
+		return false;
+
+	uint8_t r = static_cast<uint8_t>(skeleton.getColor().r * slot.getColor().r * attachmentColor->r * 255);
+	uint8_t g = static_cast<uint8_t>(skeleton.getColor().g * slot.getColor().g * attachmentColor->g * 255);
+	uint8_t b = static_cast<uint8_t>(skeleton.getColor().b * slot.getColor().b * attachmentColor->b * 255);
+	uint8_t a = static_cast<uint8_t>(skeleton.getColor().a * slot.getColor().a * attachmentColor->a * 255);
+	geometry.color = (a << 24) | (r << 16) | (g << 8) | b;
+	geometry.darkColor = 0xff000000;
+	if (slot.hasDarkColor()) {
+		Color &slotDarkColor = slot.getDarkColor();
+		geometry.darkColor = 0xff000000 | (static_cast<uint8_t>(slotDarkColor.r * 255) << 16) | (static_cast<uint8_t>(slotDarkColor.g * 255) << 8) | static_cast<uint8_t>(slotDarkColor.b * 255);
+	}
+
+	if (clipper.isClipping()) {
+		clipper.clipTriangles(*worldVertices, *geometry.indices, *geometry.uvs, 2);
+		geometry.vertices = &clipper.getClippedVertices();
+		geometry.verticesCount = (int32_t) (clipper.getClippedVertices().size() >> 1);
+		geometry.uvs = &clipper.getClippedUVs();
+		geometry.indices = &clipper.getClippedTriangles();
+		geometry.indicesCount = (int32_t) (clipper.getClippedTriangles().size());
+	}
+	return true;
+}
+
 RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 	_allocator.compress();
 	_renderCommands.clear();
 
 	SkeletonClipping &clipper = _clipping;
+	SlotGeometry geometry;
 
 	for (unsigned i = 0; i < skeleton.getSlots().size(); ++i) {
 		Slot &slot = *skeleton.getDrawOrder()[i];
-		Attachment *attachment = slot.getAttachment();
-		if (!attachment) {
-			clipper.clipEnd(slot);
-			continue;
-		}
+		if (!computeSlot(skeleton, slot, geometry)) continue;
 
-		// Early out if the slot color is 0 or the bone is not active
-		if ((slot.getColor().a == 0 || !slot.getBone().isActive()) && !attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
-			clipper.clipEnd(slot);
-			continue;
+		int32_t verticesCount = geometry.verticesCount;
+		RenderCommand *cmd = createRenderCommand(_allocator, verticesCount, geometry.indicesCount, slot.getData().getBlendMode(), geometry.texture);
+		_renderCommands.add(cmd);
+		memcpy(cmd->positions, geometry.vertices->buffer(), (verticesCount << 1) * sizeof(float));
+		memcpy(cmd->uvs, geometry.uvs->buffer(), (verticesCount << 1) * sizeof(float));
+		for (int ii = 0; ii < verticesCount; ii++) {
+			cmd->colors[ii] = geometry.color;
+			cmd->darkColors[ii] = geometry.darkColor;
 		}
+		memcpy(cmd->indices, geometry.indices->buffer(), geometry.indices->size() * sizeof(uint16_t));
+		clipper.clipEnd(slot);
+	}
+	clipper.clipEnd();
 
-		Vector<float> *worldVertices = &_worldVertices;
-		Vector<unsigned short> *quadIndices = &_quadIndices;
-		Vector<float> *vertices = worldVertices;
-		int32_t verticesCount;
-		Vector<float> *uvs;
-		Vector<unsigned short> *indices;
-		int32_t indicesCount;
-		Color *attachmentColor;
-		void *texture;
-
-		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
-			RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
-			attachmentColor = &regionAttachment->getColor();
-
-			// Early out if the slot color is 0
-			if (attachmentColor->a == 0) {
-				clipper.clipEnd(slot);
-				continue;
-			}
+	return batchCommands(_allocator, _renderCommands);
+}
 
-			worldVertices->setSize(8, 0);
-			regionAttachment->computeWorldVertices(slot, *worldVertices, 0, 2);
-			verticesCount = 4;
-			uvs = &regionAttachment->getUVs();
-			indices = quadIndices;
-			indicesCount = 6;
-			texture = regionAttachment->getRegion()->rendererObject;
-
-		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
-			MeshAttachment *mesh = (MeshAttachment *) attachment;
-			attachmentColor = &mesh->getColor();
-
-			// Early out if the slot color is 0
-			if (attachmentColor->a == 0) {
-				clipper.clipEnd(slot);
-				continue;
-			}
+bool SkeletonRenderer::render(Skeleton &skeleton, RenderSink &sink) {
+	SkeletonClipping &clipper = _clipping;
+	SlotGeometry geometry;
+	RenderBatch batch = {NULL, BlendMode_Normal, 0, 0};
+	bool complete = true;
 
-			worldVertices->setSize(mesh->getWorldVerticesLength(), 0);
-			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices->buffer(), 0, 2);
-			verticesCount = (int32_t) (mesh->getWorldVerticesLength() >> 1);
-			uvs = &mesh->getUVs();
-			indices = &mesh->getTriangles();
-			indicesCount = (int32_t) indices->size();
-			texture = mesh->getRegion()->rendererObject;
-
-		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
-			ClippingAttachment *clip = (ClippingAttachment *) slot.getAttachment();
-			clipper.clipStart(slot, clip);
-			continue;
-		} else
+	for (unsigned i = 0; i < skeleton.getSlots().size(); ++i) {
+		Slot &slot = *skeleton.getDrawOrder()[i];
+		if (!computeSlot(skeleton, slot, geometry)) continue;
+		if (geometry.verticesCount == 0 || geometry.indicesCount == 0) {
+			clipper.clipEnd(slot);
 			continue;
+		}
 
-		uint8_t r = static_cast<uint8_t>(skeleton.getColor().r * slot.getColor().r * attachmentColor->r * 255);
-		uint8_t g = static_cast<uint8_t>(skeleton.getColor().g * slot.getColor().g * attachmentColor->g * 255);
-		uint8_t b = static_cast<uint8_t>(skeleton.getColor().b * slot.getColor().b * attachmentColor->b * 255);
-		uint8_t a = static_cast<uint8_t>(skeleton.getColor().a * slot.getColor().a * attachmentColor->a * 255);
-		uint32_t color = (a << 24) | (r << 16) | (g << 8) | b;
-		uint32_t darkColor = 0xff000000;
-		if (slot.hasDarkColor()) {
-			Color &slotDarkColor = slot.getDarkColor();
-			darkColor = 0xff000000 | (static_cast<uint8_t>(slotDarkColor.r * 255) << 16) | (static_cast<uint8_t>(slotDarkColor.g * 255) << 8) | static_cast<uint8_t>(slotDarkColor.b * 255);
+		uint32_t firstVertex, firstIndex;
+		RenderVertex *vertices = sink.allocateVertices(geometry.verticesCount, firstVertex);
+		uint32_t *indices = vertices ? sink.allocateIndices(geometry.indicesCount, firstIndex) : NULL;
+		if (!indices) {
+			complete = false;
+			break;
 		}
 
-		if (clipper.isClipping()) {
-			clipper.clipTriangles(*worldVertices, *indices, *uvs, 2);
-			vertices = &clipper.getClippedVertices();
-			verticesCount = (int32_t) (clipper.getClippedVertices().size() >> 1);
-			uvs = &clipper.getClippedUVs();
-			indices = &clipper.getClippedTriangles();
-			indicesCount = (int32_t) (clipper.getClippedTriangles().size());
+		const float *positions = geometry.vertices->buffer();
+		const float *uvs = geometry.uvs->buffer();
+		for (int ii = 0; ii < geometry.verticesCount; ii++, positions += 2, uvs += 2) {
+			RenderVertex &vertex = vertices[ii];
+			vertex.x = positions[0];
+			vertex.y = positions[1];
+			vertex.u = uvs[0];
+			vertex.v = uvs[1];
+			vertex.color = geometry.color;
+			vertex.darkColor = geometry.darkColor;
 		}
+		const unsigned short *triangles = geometry.indices->buffer();
+		for (int ii = 0; ii < geometry.indicesCount; ii++)
+			indices[ii] = firstVertex + triangles[ii];
 
-		RenderCommand *cmd = createRenderCommand(_allocator, verticesCount, indicesCount, slot.getData().getBlendMode(), texture);
-		_renderCommands.add(cmd);
-		memcpy(cmd->positions, vertices->buffer(), (verticesCount << 1) * sizeof(float));
-		memcpy(cmd->uvs, uvs->buffer(), (verticesCount << 1) * sizeof(float));
-		for (int ii = 0; ii < verticesCount; ii++) {
-			cmd->colors[ii] = color;
-			cmd->darkColors[ii] = darkColor;
+		// Extend the open batch while texture and blend mode match and the indices are contiguous
+		BlendMode blendMode = slot.getData().getBlendMode();
+		if (batch.numIndices > 0 && batch.texture == geometry.texture && batch.blendMode == blendMode &&
+			batch.firstIndex + batch.numIndices == firstIndex) {
+			batch.numIndices += geometry.indicesCount;
+		} else {
+			if (batch.numIndices > 0) sink.addBatch(batch);
+			batch.texture = geometry.texture;
+			batch.blendMode = blendMode;
+			batch.firstIndex = firstIndex;
+			batch.numIndices = geometry.indicesCount;
 		}
-		memcpy(cmd->indices, indices->buffer(), indices->size() * sizeof(uint16_t));
 		clipper.clipEnd(slot);
 	}
 	clipper.clipEnd();
 
-	return batchCommands(_allocator, _renderCommands);
+	if (batch.numIndices > 0) sink.addBatch(batch);
+	return complete;
 }
@@ -40,7 +40,13 @@
 
 using namespace spine;
 
-Skin::AttachmentMap::AttachmentMap() {
+Skin::AttachmentMap::AttachmentMap() : _count(0) {
+}
+
+static size_t indexHash(size_t slotIndex, size_t nameHash) {
+	uint64_t hash = (uint64_t) nameHash ^ ((uint64_t) slotIndex * 0x9e3779b97f4a7c15ULL);
+	hash ^= hash >> 29;
+	return (size_t) hash;
 }
 
 static void disposeAttachment(Attachment *attachment) {
@@ -53,35 +59,73 @@ void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, At
 	if (slotIndex >= _buckets.size())
 		_buckets.setSize(slotIndex + 1, Vector<Entry>());
 	Vector<Entry> &bucket = _buckets[slotIndex];
-	int existing = findInBucket(bucket, attachmentName);
+	String name = String::intern(attachmentName);
+	size_t hash = name.hash();
+	int existing = find(slotIndex, name, hash);
 	attachment->reference();
 	if (existing >= 0) {
 		disposeAttachment(bucket[existing]._attachment);
 		bucket[existing]._attachment = attachment;
 	} else {
-		bucket.add(Entry(slotIndex, attachmentName, attachment));
+		bucket.add(Entry(slotIndex, name, attachment));
+		_count++;
+		if (_count * 2 > _index.size())
+			rebuildIndex();
+		else
+			insertIndex(slotIndex, hash, (int) bucket.size() - 1);
 	}
 }
 
 Attachment *Skin::AttachmentMap::get(size_t slotIndex, const String &attachmentName) {
-	if (slotIndex >= _buckets.size()) return NULL;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = find(slotIndex, attachmentName, attachmentName.hash());
 	return existing >= 0 ? _buckets[slotIndex][existing]._attachment : NULL;
 }
 
 void Skin::AttachmentMap::remove(size_t slotIndex, const String &attachmentName) {
-	if (slotIndex >= _buckets.size()) return;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = find(slotIndex, attachmentName, attachmentName.hash());
 	if (existing >= 0) {
 		disposeAttachment(_buckets[slotIndex][existing]._attachment);
 		_buckets[slotIndex].removeAt(existing);
+		_count--;
+		// Later entries of the slot moved down, removal is rare enough to reindex everything
+		rebuildIndex();
+	}
+}
+
+int Skin::AttachmentMap::find(size_t slotIndex, const String &attachmentName, size_t hash) {
+	if (_count == 0 || slotIndex >= _buckets.size()) return -1;
+	Vector<Entry> &bucket = _buckets[slotIndex];
+	size_t mask = _index.size() - 1;
+	for (size_t i = indexHash(slotIndex, hash) & mask;; i = (i + 1) & mask) {
+		IndexEntry &indexEntry = _index[i];
+		if (indexEntry.slotIndex < 0) return -1;
+		if ((size_t) indexEntry.slotIndex != slotIndex) continue;
+		Entry &entry = bucket[indexEntry.position];
+		if (entry._hash == hash && entry._name == attachmentName) return indexEntry.position;
 	}
 }
 
-int Skin::AttachmentMap::findInBucket(Vector<Entry> &bucket, const String &attachmentName) {
-	for (size_t i = 0; i < bucket.size(); i++)
-		if (bucket[i]._name == attachmentName) return (int) i;
-	return -1;
+void Skin::AttachmentMap::insertIndex(size_t slotIndex, size_t hash, int position) {
+	size_t mask = _index.size() - 1;
+	size_t i = indexHash(slotIndex, hash) & mask;
+	while (_index[i].slotIndex >= 0)
+		i = (i + 1) & mask;
+	_index[i].slotIndex = (int) slotIndex;
+	_index[i].position = position;
+}
+
+void Skin::AttachmentMap::rebuildIndex() {
+	size_t capacity = 16;
+	while (capacity < _count * 4)
+		capacity <<= 1;
+	IndexEntry empty = {-1, 0};
+	_index.clear();
+	_index.setSize(capacity, empty);
+	for (size_t slotIndex = 0; slotIndex < _buckets.size(); slotIndex++) {
+		Vector<Entry> &bucket = _buckets[slotIndex];
+		for (size_t i = 0; i < bucket.size(); i++)
+			insertIndex(slotIndex, bucket[i]._hash, (int) i);
+	}
 }
 
 Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
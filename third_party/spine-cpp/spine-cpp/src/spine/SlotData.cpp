@@ -79,7 +79,7 @@ const String &SlotData::getAttachmentName() {
 }
 
 void SlotData::setAttachmentName(const String &inValue) {
-	_attachmentName = inValue;
+	_attachmentName = String::intern(inValue);
 }
 
 BlendMode SlotData::getBlendMode() {
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/SpineString.h>
+
+#include <mutex>
+
+using namespace spine;
+
+namespace {
+	struct InternEntry {
+		size_t hash;
+		size_t length;
+		char *chars;
+	};
+
+	// Open addressing table of canonical buffers. It is allocated with malloc rather than through SpineExtension,
+	// as it outlives every SkeletonData and must not end up in an allocator arena.
+	struct InternTable {
+		std::mutex mutex;
+		InternEntry *entries;
+		size_t capacity;
+		size_t size;
+
+		InternTable() : entries(NULL), capacity(0), size(0) {
+		}
+
+		void grow() {
+			size_t newCapacity = capacity ? capacity * 2 : 256;
+			InternEntry *newEntries = (InternEntry *) ::calloc(newCapacity, sizeof(InternEntry));
+			for (size_t i = 0; i < capacity; i++) {
+				if (!entries[i].chars) continue;
+				size_t index = entries[i].hash & (newCapacity - 1);
+				while (newEntries[index].chars) index = (index + 1) & (newCapacity - 1);
+				newEntries[index] = entries[i];
+			}
+			::free(entries);
+			entries = newEntries;
+			capacity = newCapacity;
+		}
+
+		char *find(const char *chars, size_t length, size_t hash) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if ((size + 1) * 2 > capacity) grow();
+
+			size_t index = hash & (capacity - 1);
+			while (entries[index].chars) {
+				InternEntry &entry = entries[index];
+				if (entry.hash == hash && entry.length == length && memcmp(entry.chars, chars, length) == 0)
+					return entry.chars;
+				index = (index + 1) & (capacity - 1);
+			}
+
+			// The hash is stored in front of the characters so that String::hash() does not rescan them
+			char *block = (char *) ::malloc(sizeof(size_t) + length + 1);
+			memcpy(block, &hash, sizeof(size_t));
+			char *canonical = block + sizeof(size_t);
+			memcpy(canonical, chars, length);
+			canonical[length] = '\0';
+			entries[index].hash = hash;
+			entries[index].length = length;
+			entries[index].chars = canonical;
+			size++;
+			return canonical;
+		}
+	};
+
+	InternTable &internTable() {
+		// Never destroyed, interned strings may be released during static destruction
+		static InternTable *table = new InternTable();
+		return *table;
+	}
+}
+
+String String::intern(const String &chars) {
+	if (chars._interned || !chars.buffer()) return chars;
+
+	String result;
+	result._length = chars._length;
+	result._buffer = internTable().find(chars.buffer(), chars._length, chars.hash());
+	result._interned = true;
+	return result;
+}
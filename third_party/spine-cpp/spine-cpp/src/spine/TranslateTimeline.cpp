@@ -95,9 +95,7 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 			break;
 		}
 		default: {
-			x = getBezierValue(time, i, CurveTimeline2::VALUE1, curveType - CurveTimeline::BEZIER);
-			y = getBezierValue(time, i, CurveTimeline2::VALUE2,
-							   curveType + CurveTimeline::BEZIER_SIZE - CurveTimeline::BEZIER);
+			getBezierValues(time, i, curveType - CurveTimeline::BEZIER, x, y);
 		}
 	}
 
@@ -34,12 +34,131 @@
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
 
+#if defined(SPINE_NO_SIMD)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include <immintrin.h>
+#define SPINE_SKINNING_SSE2
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SPINE_SKINNING_AVX2
+#define SPINE_TARGET_AVX2
+#elif defined(__GNUC__) || defined(__clang__)
+#define SPINE_SKINNING_AVX2
+#define SPINE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 using namespace spine;
 
+// Packed weight layout, see prepareWeights().
+static const int WEIGHT_LANES = 8;
+static const int WEIGHT_BLOCK_INTS = 2 + WEIGHT_LANES;
+static const int WEIGHT_SLOT_INTS = WEIGHT_LANES * 2;
+static const int WEIGHT_SLOT_FLOATS = WEIGHT_LANES * 3;
+// Floats per bone in the transform table: a, b, worldX, c, d, worldY.
+static const int WEIGHT_TRANSFORM_FLOATS = 6;
+// Meshes influenced by more bones keep the scalar path, the transform table lives on the stack.
+static const int WEIGHT_MAX_BONES = 128;
+
+#ifdef SPINE_SKINNING_SSE2
+static void skinBlocksSse2(const int *blocks, size_t blockCount, const int *slots, const float *values,
+						   const float *transforms, const float *deform, float *wx, float *wy) {
+	for (size_t block = 0; block < blockCount; block++, blocks += WEIGHT_BLOCK_INTS) {
+		for (int half = 0; half < WEIGHT_LANES; half += 4) {
+			__m128i counts = _mm_loadu_si128((const __m128i *) (blocks + 2 + half));
+			__m128 x = _mm_setzero_ps(), y = _mm_setzero_ps();
+			const int *slot = slots + blocks[0] * WEIGHT_SLOT_INTS + half;
+			const float *value = values + blocks[0] * WEIGHT_SLOT_FLOATS + half;
+			for (int k = 0, n = blocks[1]; k < n; k++, slot += WEIGHT_SLOT_INTS, value += WEIGHT_SLOT_FLOATS) {
+				const float *t0 = transforms + slot[0], *t1 = transforms + slot[1];
+				const float *t2 = transforms + slot[2], *t3 = transforms + slot[3];
+				__m128 vx = _mm_loadu_ps(value), vy = _mm_loadu_ps(value + WEIGHT_LANES);
+				__m128 weight = _mm_loadu_ps(value + WEIGHT_LANES * 2);
+				if (deform) {
+					const int *f = slot + WEIGHT_LANES;
+					vx = _mm_add_ps(vx, _mm_setr_ps(deform[f[0] << 1], deform[f[1] << 1], deform[f[2] << 1],
+													deform[f[3] << 1]));
+					vy = _mm_add_ps(vy, _mm_setr_ps(deform[(f[0] << 1) + 1], deform[(f[1] << 1) + 1],
+													deform[(f[2] << 1) + 1], deform[(f[3] << 1) + 1]));
+				}
+				__m128 a = _mm_setr_ps(t0[0], t1[0], t2[0], t3[0]), b = _mm_setr_ps(t0[1], t1[1], t2[1], t3[1]);
+				__m128 c = _mm_setr_ps(t0[3], t1[3], t2[3], t3[3]), d = _mm_setr_ps(t0[4], t1[4], t2[4], t3[4]);
+				__m128 worldX = _mm_setr_ps(t0[2], t1[2], t2[2], t3[2]);
+				__m128 worldY = _mm_setr_ps(t0[5], t1[5], t2[5], t3[5]);
+				// Same operation order as the scalar loop. Lanes without a k-th influence add +0, which
+				// leaves the sum unchanged because a sum starting at +0 is never -0.
+				__m128 active = _mm_castsi128_ps(_mm_cmpgt_epi32(counts, _mm_set1_epi32(k)));
+				__m128 tx = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, a), _mm_mul_ps(vy, b)), worldX), weight);
+				__m128 ty = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, c), _mm_mul_ps(vy, d)), worldY), weight);
+				x = _mm_add_ps(x, _mm_and_ps(tx, active));
+				y = _mm_add_ps(y, _mm_and_ps(ty, active));
+			}
+			_mm_storeu_ps(wx + block * WEIGHT_LANES + half, x);
+			_mm_storeu_ps(wy + block * WEIGHT_LANES + half, y);
+		}
+	}
+}
+#endif
+
+#ifdef SPINE_SKINNING_AVX2
+// No FMA: fused multiply-adds would round differently than the scalar loop.
+SPINE_TARGET_AVX2
+static void skinBlocksAvx2(const int *blocks, size_t blockCount, const int *slots, const float *values,
+						   const float *transforms, const float *deform, float *wx, float *wy) {
+	for (size_t block = 0; block < blockCount; block++, blocks += WEIGHT_BLOCK_INTS) {
+		__m256i counts = _mm256_loadu_si256((const __m256i *) (blocks + 2));
+		__m256 x = _mm256_setzero_ps(), y = _mm256_setzero_ps();
+		const int *slot = slots + blocks[0] * WEIGHT_SLOT_INTS;
+		const float *value = values + blocks[0] * WEIGHT_SLOT_FLOATS;
+		for (int k = 0, n = blocks[1]; k < n; k++, slot += WEIGHT_SLOT_INTS, value += WEIGHT_SLOT_FLOATS) {
+			__m256i bones = _mm256_loadu_si256((const __m256i *) slot);
+			__m256 vx = _mm256_loadu_ps(value), vy = _mm256_loadu_ps(value + WEIGHT_LANES);
+			__m256 weight = _mm256_loadu_ps(value + WEIGHT_LANES * 2);
+			if (deform) {
+				__m256i f = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i *) (slot + WEIGHT_LANES)), 1);
+				vx = _mm256_add_ps(vx, _mm256_i32gather_ps(deform, f, 4));
+				vy = _mm256_add_ps(vy, _mm256_i32gather_ps(deform + 1, f, 4));
+			}
+			__m256 a = _mm256_i32gather_ps(transforms, bones, 4), b = _mm256_i32gather_ps(transforms + 1, bones, 4);
+			__m256 c = _mm256_i32gather_ps(transforms + 3, bones, 4), d = _mm256_i32gather_ps(transforms + 4, bones, 4);
+			__m256 worldX = _mm256_i32gather_ps(transforms + 2, bones, 4);
+			__m256 worldY = _mm256_i32gather_ps(transforms + 5, bones, 4);
+			__m256 active = _mm256_castsi256_ps(_mm256_cmpgt_epi32(counts, _mm256_set1_epi32(k)));
+			__m256 tx = _mm256_mul_ps(
+					_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, a), _mm256_mul_ps(vy, b)), worldX), weight);
+			__m256 ty = _mm256_mul_ps(
+					_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, c), _mm256_mul_ps(vy, d)), worldY), weight);
+			x = _mm256_add_ps(x, _mm256_and_ps(tx, active));
+			y = _mm256_add_ps(y, _mm256_and_ps(ty, active));
+		}
+		_mm256_storeu_ps(wx + block * WEIGHT_LANES, x);
+		_mm256_storeu_ps(wy + block * WEIGHT_LANES, y);
+	}
+}
+
+static bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+	__cpuid(info, 1);
+	// AVX and OSXSAVE, and the OS saves the YMM registers.
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
 RTTI_IMPL(VertexAttachment, Attachment)
 
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0),
-														 _timelineAttachment(this), _id(getNextID()) {
+														 _timelineAttachment(this), _id(getNextID()),
+														 _weightVerticesSize(0) {
 }
 
 VertexAttachment::~VertexAttachment() {
@@ -60,6 +179,7 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 
 void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 											size_t stride) {
+	size_t valueCount = count;
 	count = offset + (count >> 1) * stride;
 	Skeleton &skeleton = slot._bone._skeleton;
 	Vector<float> *deformArray = &slot.getDeform();
@@ -81,6 +201,8 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		return;
 	}
 
+	if (computeWeightedPacked(slot, start, valueCount, worldVertices, offset, stride)) return;
+
 	int v = 0, skip = 0;
 	for (size_t i = 0; i < start; i += 2) {
 		int n = (int) bones[v];
@@ -164,4 +286,131 @@ void VertexAttachment::copyTo(VertexAttachment *other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_timelineAttachment = this->_timelineAttachment;
+	other->prepareWeights();
+}
+
+void VertexAttachment::prepareWeights() {
+	_weightBlocks.clear();
+	_weightSlots.clear();
+	_weightValues.clear();
+	_weightBoneIndices.clear();
+	_weightVerticesSize = 0;
+#ifdef SPINE_SKINNING_SSE2
+	if (_bones.size() == 0) return;
+
+	// Per vertex: index of its influence count in _bones and of its first influence.
+	Vector<int> vertexBones, vertexInfluences;
+	int maxBone = 0;
+	for (int v = 0, influence = 0, n = (int) _bones.size(); v < n;) {
+		int count = _bones[v];
+		vertexBones.add(v);
+		vertexInfluences.add(influence);
+		for (int i = 1; i <= count; i++)
+			if (_bones[v + i] > maxBone) maxBone = _bones[v + i];
+		v += count + 1;
+		influence += count;
+	}
+
+	// Transform table entries only for the bones this attachment uses.
+	Vector<int> tableOffsets;
+	tableOffsets.setSize(maxBone + 1, -1);
+	for (size_t v = 0, n = vertexBones.size(); v < n; v++) {
+		for (int i = 1, count = _bones[vertexBones[v]]; i <= count; i++) {
+			int bone = _bones[vertexBones[v] + i];
+			if (tableOffsets[bone] != -1) continue;
+			if ((int) _weightBoneIndices.size() == WEIGHT_MAX_BONES) {
+				_weightBoneIndices.clear();
+				return;
+			}
+			tableOffsets[bone] = (int) _weightBoneIndices.size() * WEIGHT_TRANSFORM_FLOATS;
+			_weightBoneIndices.add(bone);
+		}
+	}
+
+	int slotCount = 0;
+	for (size_t first = 0, n = vertexBones.size(); first < n; first += WEIGHT_LANES) {
+		int counts[WEIGHT_LANES] = {0}, maxCount = 0;
+		for (int lane = 0; lane < WEIGHT_LANES && first + lane < n; lane++) {
+			counts[lane] = _bones[vertexBones[first + lane]];
+			if (counts[lane] > maxCount) maxCount = counts[lane];
+		}
+
+		_weightBlocks.add(slotCount);
+		_weightBlocks.add(maxCount);
+		for (int lane = 0; lane < WEIGHT_LANES; lane++)
+			_weightBlocks.add(counts[lane]);
+
+		for (int k = 0; k < maxCount; k++, slotCount++) {
+			size_t ints = _weightSlots.size(), floats = _weightValues.size();
+			_weightSlots.setSize(ints + WEIGHT_SLOT_INTS, 0);
+			_weightValues.setSize(floats + WEIGHT_SLOT_FLOATS, 0);
+			for (int lane = 0; lane < WEIGHT_LANES; lane++) {
+				if (k >= counts[lane]) continue;
+				int influence = vertexInfluences[first + lane] + k;
+				_weightSlots[ints + lane] = tableOffsets[_bones[vertexBones[first + lane] + 1 + k]];
+				_weightSlots[ints + WEIGHT_LANES + lane] = influence;
+				_weightValues[floats + lane] = _vertices[influence * 3];
+				_weightValues[floats + WEIGHT_LANES + lane] = _vertices[influence * 3 + 1];
+				_weightValues[floats + WEIGHT_LANES * 2 + lane] = _vertices[influence * 3 + 2];
+			}
+		}
+	}
+	_weightVerticesSize = _vertices.size();
+#endif
+}
+
+bool VertexAttachment::computeWeightedPacked(Slot &slot, size_t start, size_t count, float *worldVertices,
+											 size_t offset, size_t stride) {
+#ifdef SPINE_SKINNING_SSE2
+	if (start != 0 || _weightBlocks.size() == 0 || _vertices.size() != _weightVerticesSize) return false;
+
+	Vector<Bone *> &skeletonBones = slot._bone._skeleton.getBones();
+	float transforms[WEIGHT_MAX_BONES * WEIGHT_TRANSFORM_FLOATS];
+	for (size_t i = 0, n = _weightBoneIndices.size(); i < n; i++) {
+		Bone &bone = *skeletonBones[_weightBoneIndices[i]];
+		float *transform = transforms + i * WEIGHT_TRANSFORM_FLOATS;
+		transform[0] = bone._a;
+		transform[1] = bone._b;
+		transform[2] = bone._worldX;
+		transform[3] = bone._c;
+		transform[4] = bone._d;
+		transform[5] = bone._worldY;
+	}
+
+	Vector<float> &deformArray = slot.getDeform();
+	const float *deform = deformArray.size() > 0 ? deformArray.buffer() : NULL;
+	size_t vertexCount = count >> 1, blockCount = _weightBlocks.size() / WEIGHT_BLOCK_INTS;
+
+	// Skin a chunk of blocks into a small buffer, then write the requested vertices with the caller's stride.
+	const size_t chunkBlocks = 16;
+	float wx[chunkBlocks * WEIGHT_LANES], wy[chunkBlocks * WEIGHT_LANES];
+#ifdef SPINE_SKINNING_AVX2
+	static const bool avx2 = cpuHasAvx2();
+#endif
+	size_t vertex = 0, w = offset;
+	for (size_t block = 0; block < blockCount && vertex < vertexCount; block += chunkBlocks) {
+		size_t blocks = blockCount - block < chunkBlocks ? blockCount - block : chunkBlocks;
+		const int *blockData = _weightBlocks.buffer() + block * WEIGHT_BLOCK_INTS;
+#ifdef SPINE_SKINNING_AVX2
+		if (avx2)
+			skinBlocksAvx2(blockData, blocks, _weightSlots.buffer(), _weightValues.buffer(), transforms, deform, wx, wy);
+		else
+#endif
+			skinBlocksSse2(blockData, blocks, _weightSlots.buffer(), _weightValues.buffer(), transforms, deform, wx, wy);
+
+		for (size_t i = 0, n = blocks * WEIGHT_LANES; i < n && vertex < vertexCount; i++, vertex++, w += stride) {
+			worldVertices[w] = wx[i];
+			worldVertices[w + 1] = wy[i];
+		}
+	}
+	return true;
+#else
+	SP_UNUSED(slot);
+	SP_UNUSED(start);
+	SP_UNUSED(count);
+	SP_UNUSED(worldVertices);
+	SP_UNUSED(offset);
+	SP_UNUSED(stride);
+	return false;
+#endif
 }
@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+
+// Converts a JSON skeleton with SkeletonBinaryWriter, reads it back with SkeletonBinary (eager and lazy) and
+// samples every animation of all three SkeletonData side by side.
+//
+// Tolerances: the binary format stores the same floats as the JSON, but the writer re-derives bezier control
+// points from the sampled curves, so poses between keys may differ slightly. Bone world matrices, world
+// positions and deform offsets must agree within 1e-3, colors within one 8-bit step (1/255). Attachments, draw
+// order and fired events must match exactly. Eager and lazy reads decode the same bytes and must be identical.
+
+#include <spine/spine.h>
+
+#include <cmath>
+#include <cstdio>
+
+using namespace spine;
+
+SpineExtension *spine::getDefaultExtension() {
+	return new DefaultSpineExtension();
+}
+
+namespace {
+	const float TRANSFORM_TOLERANCE = 1e-3f;
+	const float COLOR_TOLERANCE = 1.0f / 255;
+	const float SAMPLE_STEP = 1.0f / 60;
+
+	class NullTextureLoader : public TextureLoader {
+	public:
+		void load(AtlasPage &, const String &) {}
+
+		void unload(void *) {}
+	};
+
+	struct Comparison {
+		const char *label;
+		const char *animation;
+		float time;
+		int failures;
+
+		void fail(const char *what, const char *detail) {
+			if (failures++ < 20) printf("  %s, %s at %.4f: %s %s\n", label, animation, time, what, detail);
+		}
+
+		void check(float expected, float actual, float tolerance, const char *what) {
+			if (std::fabs(expected - actual) <= tolerance) return;
+			char detail[64];
+			snprintf(detail, sizeof(detail), "%g != %g", expected, actual);
+			fail(what, detail);
+		}
+
+		void check(const Color &expected, const Color &actual, float tolerance, const char *what) {
+			check(expected.r, actual.r, tolerance, what);
+			check(expected.g, actual.g, tolerance, what);
+			check(expected.b, actual.b, tolerance, what);
+			check(expected.a, actual.a, tolerance, what);
+		}
+
+		void check(const String &expected, const String &actual, const char *what) {
+			if (expected == actual) return;
+			char detail[128];
+			snprintf(detail, sizeof(detail), "'%s' != '%s'", expected.buffer() ? expected.buffer() : "",
+					 actual.buffer() ? actual.buffer() : "");
+			fail(what, detail);
+		}
+	};
+
+	const char *attachmentName(Slot *slot) {
+		return slot->getAttachment() ? slot->getAttachment()->getName().buffer() : "";
+	}
+
+	void compareSkeletons(Comparison &comparison, Skeleton &expected, Skeleton &actual, float tolerance,
+						  float colorTolerance) {
+		Vector<Bone *> &expectedBones = expected.getBones(), &actualBones = actual.getBones();
+		for (size_t i = 0; i < expectedBones.size(); i++) {
+			Bone &a = *expectedBones[i], &b = *actualBones[i];
+			comparison.check(a.getA(), b.getA(), tolerance, a.getData().getName().buffer());
+			comparison.check(a.getB(), b.getB(), tolerance, a.getData().getName().buffer());
+			comparison.check(a.getC(), b.getC(), tolerance, a.getData().getName().buffer());
+			comparison.check(a.getD(), b.getD(), tolerance, a.getData().getName().buffer());
+			comparison.check(a.getWorldX(), b.getWorldX(), tolerance, a.getData().getName().buffer());
+			comparison.check(a.getWorldY(), b.getWorldY(), tolerance, a.getData().getName().buffer());
+		}
+
+		Vector<Slot *> &expectedSlots = expected.getSlots(), &actualSlots = actual.getSlots();
+		for (size_t i = 0; i < expectedSlots.size(); i++) {
+			Slot &a = *expectedSlots[i], &b = *actualSlots[i];
+			const char *name = a.getData().getName().buffer();
+			comparison.check(a.getColor(), b.getColor(), colorTolerance, name);
+			if (a.hasDarkColor()) comparison.check(a.getDarkColor(), b.getDarkColor(), colorTolerance, name);
+			comparison.check(String(attachmentName(&a)), String(attachmentName(&b)), "attachment");
+
+			Vector<float> &expectedDeform = a.getDeform(), &actualDeform = b.getDeform();
+			if (expectedDeform.size() != actualDeform.size()) {
+				comparison.fail("deform size", name);
+				continue;
+			}
+			for (size_t v = 0; v < expectedDeform.size(); v++)
+				comparison.check(expectedDeform[v], actualDeform[v], tolerance, "deform");
+
+			comparison.check(expected.getDrawOrder()[i]->getData().getName(), actual.getDrawOrder()[i]->getData().getName(),
+							 "draw order");
+		}
+	}
+
+	void compareEvents(Comparison &comparison, Vector<Event *> &expected, Vector<Event *> &actual) {
+		if (expected.size() != actual.size()) {
+			char detail[64];
+			snprintf(detail, sizeof(detail), "%d != %d", (int) expected.size(), (int) actual.size());
+			comparison.fail("event count", detail);
+			return;
+		}
+		for (size_t i = 0; i < expected.size(); i++) {
+			Event &a = *expected[i], &b = *actual[i];
+			comparison.check(a.getData().getName(), b.getData().getName(), "event");
+			comparison.check(a.getTime(), b.getTime(), 0, "event time");
+			comparison.check((float) a.getIntValue(), (float) b.getIntValue(), 0, "event int");
+			comparison.check(a.getFloatValue(), b.getFloatValue(), 0, "event float");
+			comparison.check(a.getStringValue(), b.getStringValue(), "event string");
+			comparison.check(a.getVolume(), b.getVolume(), 0, "event volume");
+			comparison.check(a.getBalance(), b.getBalance(), 0, "event balance");
+		}
+	}
+
+	/// Samples every animation of expected at SAMPLE_STEP and at its end, applying the same animation of actual.
+	/// Events are collected over the interval since the previous sample.
+	int compare(const char *label, SkeletonData &expected, SkeletonData &actual, float tolerance,
+				float colorTolerance) {
+		Comparison comparison = {label, "", 0, 0};
+		int samples = 0;
+		Vector<Animation *> &animations = expected.getAnimations();
+		for (size_t i = 0; i < animations.size(); i++) {
+			Animation *expectedAnimation = animations[i];
+			Animation *actualAnimation = actual.findAnimation(expectedAnimation->getName());
+			comparison.animation = expectedAnimation->getName().buffer();
+			if (!actualAnimation) {
+				comparison.fail("missing animation", "");
+				continue;
+			}
+			comparison.check(expectedAnimation->getDuration(), actualAnimation->getDuration(), 0, "duration");
+
+			Skeleton expectedSkeleton(&expected), actualSkeleton(&actual);
+			Vector<Event *> expectedEvents, actualEvents;
+			float duration = expectedAnimation->getDuration(), lastTime = -1;
+			int count = (int) std::ceil(duration / SAMPLE_STEP);
+			for (int frame = 0; frame <= count; frame++, samples++) {
+				float time = frame == count ? duration : frame * SAMPLE_STEP;
+				comparison.time = time;
+				expectedEvents.clear();
+				actualEvents.clear();
+
+				expectedSkeleton.setToSetupPose();
+				actualSkeleton.setToSetupPose();
+				expectedAnimation->apply(expectedSkeleton, lastTime, time, false, &expectedEvents, 1, MixBlend_Setup,
+										 MixDirection_In);
+				actualAnimation->apply(actualSkeleton, lastTime, time, false, &actualEvents, 1, MixBlend_Setup,
+									   MixDirection_In);
+				expectedSkeleton.updateWorldTransform(Physics_None);
+				actualSkeleton.updateWorldTransform(Physics_None);
+
+				compareSkeletons(comparison, expectedSkeleton, actualSkeleton, tolerance, colorTolerance);
+				compareEvents(comparison, expectedEvents, actualEvents);
+				lastTime = time;
+			}
+		}
+		printf("%s: %d samples, %d failures\n", label, samples, comparison.failures);
+		return comparison.failures;
+	}
+}
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		printf("Usage: %s <fixture directory>\n", argv[0]);
+		return 2;
+	}
+	String directory(argv[1]);
+
+	NullTextureLoader textureLoader;
+	Atlas atlas(String(directory).append("/roundtrip.atlas"), &textureLoader);
+	if (atlas.getPages().size() == 0) {
+		printf("Could not read roundtrip.atlas\n");
+		return 1;
+	}
+
+	SkeletonJson json(&atlas);
+	SkeletonData *reference = json.readSkeletonDataFile(String(directory).append("/roundtrip.json"));
+	if (!reference) {
+		printf("Could not read roundtrip.json: %s\n", json.getError().buffer());
+		return 1;
+	}
+
+	SkeletonBinaryWriter writer;
+	Vector<unsigned char> bytes;
+	if (!writer.writeSkeletonData(*reference, bytes)) {
+		printf("Could not write binary: %s\n", writer.getError().buffer());
+		delete reference;
+		return 1;
+	}
+
+	SkeletonBinary eagerBinary(&atlas);
+	SkeletonData *eager = eagerBinary.readSkeletonData(bytes.buffer(), (int) bytes.size());
+	SkeletonBinary lazyBinary(&atlas);
+	lazyBinary.setLazyAnimations(true);
+	SkeletonData *lazy = lazyBinary.readSkeletonData(bytes.buffer(), (int) bytes.size());
+	if (!eager || !lazy) {
+		printf("Could not read binary: %s%s\n", eagerBinary.getError().buffer(), lazyBinary.getError().buffer());
+		delete reference;
+		delete eager;
+		delete lazy;
+		return 1;
+	}
+
+	int failures = 0;
+	for (size_t i = 0; i < lazy->getAnimations().size(); i++) {
+		if (lazy->getAnimations()[i]->isLoaded()) {
+			printf("Lazy animation %s was decoded while reading\n", lazy->getAnimations()[i]->getName().buffer());
+			failures++;
+		}
+	}
+
+	failures += compare("json vs eager binary", *reference, *eager, TRANSFORM_TOLERANCE, COLOR_TOLERANCE);
+	failures += compare("json vs lazy binary", *reference, *lazy, TRANSFORM_TOLERANCE, COLOR_TOLERANCE);
+	failures += compare("eager vs lazy binary", *eager, *lazy, 0, 0);
+
+	delete reference;
+	delete eager;
+	delete lazy;
+	return failures == 0 ? 0 : 1;
+}